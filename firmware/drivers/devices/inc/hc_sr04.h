@@ -14,6 +14,9 @@
  * 
  * @note When disconnected return 0.
  * 
+ * The echo pulse is measured with the edge capture driver (capture_mcu.h), the task
+ * is blocked (not polling) while waiting for the echo.
+ * 
  * @note When ussing dedicated connector in ESP-EDU:
  * |   HC_SR04      |   EDU-CIAA	|
  * |:--------------:|:-------------:|
@@ -29,6 +32,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Echo measured with edge capture										|
  * 
  **/
 
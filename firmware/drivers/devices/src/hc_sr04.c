@@ -12,6 +12,7 @@
 /*==================[inclusions]=============================================*/
 #include "hc_sr04.h"
 #include "delay_mcu.h"
+#include "capture_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define MAX_US		17700	/* maximun distance time in us (300cm or 118inch) */
 #define MAX_CM		300		/* maximun distance time in cm */
@@ -22,12 +23,26 @@
 /*==================[internal data declaration]==============================*/
 static gpio_t echo_st, trigger_st; /**<  Stores the pin inicilization*/
 /*==================[internal functions declaration]=========================*/
+static bool HcSr04Echo(uint32_t *width);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Trigger a measurement and wait for the echo pulse
+ * 
+ * @param width Echo pulse width in us (MAX_US if longer)
+ * @return false No echo
+ */
+static bool HcSr04Echo(uint32_t *width){
+	CaptureFlush(echo_st);
+	GPIOOn(trigger_st);
+	DelayUs(10);
+	GPIOOff(trigger_st);
+	return CaptureWaitPulse(echo_st, true, WAIT_MAX, MAX_US, width);
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -36,57 +51,35 @@ bool HcSr04Init(gpio_t echo, gpio_t trigger){
 	trigger_st = trigger;
 
 	/** Configuration of the GPIO pins*/
-	GPIOInit(echo, GPIO_INPUT);
 	GPIOInit(trigger, GPIO_OUTPUT);
 
-	return true;
+	return CaptureInit(echo, 1);
 }
 
 uint16_t HcSr04ReadDistanceInCentimeters(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(10);
-		waiting += 10;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
+	uint32_t width;
+	if(!HcSr04Echo(&width)){
+		return 0;
 	}
-	do{
-		DelayUs(10);
-		distance += 10;
-		if(distance > MAX_US)
-			return MAX_CM;
+	if(width >= MAX_US){
+		return MAX_CM;
 	}
-	while(GPIORead(echo_st));
-	return (distance/US2CM);
+	return (width/US2CM);
 }
 
 uint16_t HcSr04ReadDistanceInInches(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(10);
-		waiting += 10;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
+	uint32_t width;
+	if(!HcSr04Echo(&width)){
+		return 0;
 	}
-	do{
-		DelayUs(10);
-		distance += 10;
-		if(distance > MAX_US)
-			return MAX_INCH;
+	if(width >= MAX_US){
+		return MAX_INCH;
 	}
-	while(GPIORead(echo_st));
-	return (distance/US2INCH);
+	return (width/US2INCH);
 }
 
 bool HcSr04Deinit(void){
+	CaptureDeinit(echo_st);
 	GPIODeinit();
 	return true;
 }
@@ -21,11 +21,17 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 24/02/2024 | Document creation		                         						|
+ * | 18/10/2026 | Waveform playback on the DAC from the timer ISR						|
+ * | 18/10/2026 | Continuous (DMA) multi-channel conversion								|
+ * | 18/10/2026 | Zero-copy frame ring for continuous mode								|
+ * | 18/10/2026 | Batch calibrated conversion (raw to mV / V)							|
+ * | 18/10/2026 | Scan timestamps and inter-channel skew compensation					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 typedef enum adc_ch {
 	CH0 = 0,				/*!< Channel 0 */
@@ -40,7 +46,38 @@ typedef enum adc_mode {
 } adc_mode_t;
 
 #define DAC	0    			/*!< DAC pin. Override CH0 declaration*/
+
+typedef enum dac_playback_mode {
+	DAC_ONE_SHOT,			/*!< Play the buffer (and the queued ones) once */
+	DAC_LOOP,				/*!< Repeat the last buffer until a new one is queued or playback is stopped */
+} dac_playback_mode_t;
 /*==================[typedef]================================================*/
+/**
+ * @brief Continuous mode frame descriptor
+ * 
+ */
+typedef struct {
+	uint16_t *samples;			/*!< Raw samples, one block of frame_len samples per scanned channel (in channel order) */
+	uint16_t frame_len;			/*!< Samples per channel */
+	uint8_t channels;			/*!< Scanned channels */
+	uint32_t seq;				/*!< Frame sequence number, a gap means dropped frames */
+	int64_t timestamp;			/*!< Time of the first scan in the frame (us, esp_timer time base) */
+	float scan_period;			/*!< Time between scans (us) */
+	float channel_skew;			/*!< Time between consecutive channels in a scan (us) */
+} analog_frame_t;
+
+/**
+ * @brief Continuous mode frame callback, called from the ISR with each new frame.
+ * 
+ * The frame (frame_len samples of each of the channels) is read only and valid until the ISR
+ * reuses its slot of the ring, 4 frames later (with frame_ring, until it is borrowed and released).
+ * 
+ * @param frame New frame
+ * @param param Callback function parameters (param_p)
+ * @return true A higher priority task was woken (xHigherPriorityTaskWoken), a context switch is requested
+ */
+typedef bool (*analog_frame_func_t)(const analog_frame_t *frame, void *param);
+
 /**
  * @brief Analog inputs config structure
  * 
@@ -49,10 +86,37 @@ typedef struct {
 	adc_ch_t input;			/*!< Inputs: CH0, CH1, CH2, CH3 */
 	adc_mode_t mode;		/*!< Mode: single read or continuous read */
 	void *func_p;			/*!< Pointer to callback function for convertion end (only for continuous mode) */
+	analog_frame_func_t frame_func_p;	/*!< Callback with the new frame, used instead of func_p if not NULL (only for continuous mode) */
 	void *param_p;			/*!< Pointer to callback function parameters (only for continuous mode) */
-	uint16_t sample_frec;	/*!< Sample frequency min: 20kHz - max: 2MHz (only for continuous mode)  */
+	uint16_t sample_frec;	/*!< Sample frequency per channel in Hz, max: 83333 / channels (only for continuous mode) */
+	uint16_t frame_len;		/*!< Samples per channel in each conversion frame, 0: 64 (only for continuous mode) */
+	bool frame_ring;		/*!< true: frames are handed over with AnalogInputFrameBorrow() and never overwritten (only for continuous mode) */
 } analog_input_config_t;	
 
+/**
+ * @brief Analog output waveform playback config structure
+ * 
+ */
+typedef struct {
+	const uint8_t *buffer;		/*!< First waveform buffer (DAC values from 0 to 255) */
+	uint32_t len;				/*!< Amount of samples in buffer */
+	uint32_t sample_frec;		/*!< Sample frequency in Hz (max: 100kHz) */
+	dac_playback_mode_t mode;	/*!< One shot or loop */
+	void *func_p;				/*!< Pointer to callback function called (from ISR) each time a buffer ends, may be NULL */
+	void *param_p;				/*!< Pointer to callback function parameters */
+} analog_output_playback_t;
+
+/**
+ * @brief Continuous mode frame ring statistics
+ * 
+ */
+typedef struct {
+	uint32_t frames;			/*!< Frames published since the scan started */
+	uint32_t overruns;			/*!< Frames dropped because the ring was full (only with frame_ring) */
+	uint8_t pending;			/*!< Frames published and not yet released */
+	uint8_t high_water;			/*!< Max frames pending at once (only with frame_ring) */
+} analog_frame_stats_t;
+
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -83,25 +147,134 @@ void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value);
 /**
  * @brief Start convertion for ADC module in continuous mode
  * 
+ * The ADC scans every started channel (previously initialized in ADC_CONTINUOUS mode)
+ * and DMA fills one frame of frame_len samples per channel. At the end of each frame the
+ * callback is called (from ISR), the frame can be then read with AnalogInputReadContinuous().
+ * Starting a channel while others are running restarts the scan with the new pattern.
+ * 
+ * @note sample_frec, frame_len, func_p, frame_func_p and param_p are shared by all the continuous
+ * channels, the last initialized channel sets them.
+ * @note ADC single reads are not available while continuous conversion is running.
+ * 
  * @param channel Channel selected
+ * @return true Channel scanned
+ * @return false Channel not initialized in continuous mode, a frame is borrowed (the scan is
+ * not changed, release the frame first) or configuration rejected by the ADC driver (the
+ * conversion of all the channels is stopped)
  */
-void AnalogStartContinuous(adc_ch_t channel);
+bool AnalogStartContinuous(adc_ch_t channel);
 
 /**
  * @brief Stop convertion for ADC module
  * 
+ * The channel is removed from the scan, the conversion stops when no channels are left.
+ * 
  * @param channel Channel selected
+ * @return true Channel removed
+ * @return false Not valid channel, a frame is borrowed (the scan is not changed, release the
+ * frame first) or the scan of the remaining channels could not be restarted (the conversion
+ * of all the channels is stopped)
  */
-void AnalogStopContinuous(adc_ch_t channel);
+bool AnalogStopContinuous(adc_ch_t channel);
 
 /**
- * @brief 
+ * @brief Read the last complete frame of a channel in continuous mode.
+ * 
+ * @note Samples are copied, see AnalogInputFrameBorrow() for zero-copy access.
  * 
  * @param channel Channel selected.
- * @param values Read variable array
+ * @param values Read variable array (raw values), at least frame_len samples long
  */
 void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
 
+/**
+ * @brief Convert an array of raw values to mV.
+ * 
+ * Uses a table sampled from the channel calibration curve at initialization, so
+ * there is no calibration driver call per sample. Between knots (every 64 raw counts)
+ * the curve is linearly interpolated.
+ * 
+ * @note The channel must be initialized first. raw and mv may be the same array.
+ * 
+ * @param channel Channel the values were read from
+ * @param raw Raw values
+ * @param mv Converted values (in mV)
+ * @param len Amount of values
+ */
+void AnalogInputRawToMv(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint32_t len);
+
+/**
+ * @brief Convert an array of raw values to V (float), ready for DSP processing.
+ * 
+ * @note The channel must be initialized first.
+ * 
+ * @param channel Channel the values were read from
+ * @param raw Raw values
+ * @param volts Converted values (in V)
+ * @param len Amount of values
+ */
+void AnalogInputRawToVolts(adc_ch_t channel, const uint16_t *raw, float *volts, uint32_t len);
+
+/**
+ * @brief Borrow the oldest pending frame in continuous mode (frame_ring enabled).
+ * 
+ * The frame is not copied, it can be processed in place and must be given back with
+ * AnalogInputFrameRelease(). Until then the ISR fills the other frames of the ring and
+ * drops new ones when it is full. Borrowing again without releasing returns the same frame.
+ * 
+ * @note Single consumer: borrow and release must be called from one task.
+ * @note Changing the scan clears the ring, AnalogStartContinuous() and AnalogStopContinuous()
+ * fail while a frame is borrowed.
+ * 
+ * @return analog_frame_t* Oldest pending frame, NULL if there are none
+ */
+analog_frame_t* AnalogInputFrameBorrow(void);
+
+/**
+ * @brief Give the borrowed frame back to the ring.
+ */
+void AnalogInputFrameRelease(void);
+
+/**
+ * @brief Get the samples of one channel in a frame.
+ * 
+ * @param frame Frame descriptor
+ * @param channel Channel selected
+ * @return uint16_t* First sample of the channel (frame_len samples), NULL if the channel is not scanned
+ */
+uint16_t* AnalogInputFrameChannel(analog_frame_t *frame, adc_ch_t channel);
+
+/**
+ * @brief Get the time when a scan in a frame was sampled.
+ * 
+ * The scan is hardware timed, channels in a scan are sampled one after the other
+ * (channel_skew apart) and the scan repeats every scan_period. The time returned is the
+ * one of the first channel of the scan, the rest are delayed by their position times channel_skew.
+ * 
+ * @param frame Frame descriptor
+ * @param scan Scan index in the frame (from 0 to frame_len - 1)
+ * @return int64_t Scan time (us, esp_timer time base)
+ */
+int64_t AnalogInputFrameScanTime(const analog_frame_t *frame, uint16_t scan);
+
+/**
+ * @brief Compensate the inter-channel skew of a frame in place.
+ * 
+ * Every channel is linearly interpolated to the sample time of the first scanned channel,
+ * so all the channels of a scan share the scan time. The last samples of the previous frame
+ * are kept to interpolate the first scan, frames must be processed in order.
+ * 
+ * @param frame Frame descriptor
+ */
+void AnalogInputFrameDeskew(analog_frame_t *frame);
+
+/**
+ * @brief Get the frame ring statistics (cleared when the scan changes).
+ * 
+ * @param stats Statistics structure
+ */
+void AnalogInputFrameStats(analog_frame_stats_t *stats);
+
 /**
  * @brief Digital-to-Analog convert.
  * 
@@ -109,6 +282,46 @@ void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
  */
 void AnalogOutputWrite(uint8_t value);
 
+/**
+ * @brief Start waveform playback on the DAC.
+ * 
+ * Samples are written to the DAC directly from a dedicated timer ISR, no task is involved.
+ * While a buffer is playing, the next one can be queued with AnalogOutputPlaybackQueue()
+ * (double buffering). The callback is called from the ISR each time a buffer ends, the
+ * ended buffer can then be refilled and queued again.
+ * 
+ * @note Buffers are not copied, they must remain valid until they end.
+ * @note The sample period is rounded to a 0.1 us timer tick, the actual sample frequency is
+ * returned (e.g. 44100 Hz plays at 44053 Hz).
+ * 
+ * @param config Playback config structure
+ * @return uint32_t Actual sample frequency in Hz, 0 if the config is not valid or the timer is not available
+ */
+uint32_t AnalogOutputPlaybackStart(analog_output_playback_t *config);
+
+/**
+ * @brief Queue the next buffer, it starts just after the current one ends.
+ * 
+ * @param buffer Waveform buffer (DAC values from 0 to 255)
+ * @param len Amount of samples in buffer
+ * @return true Buffer queued
+ * @return false There is already a queued buffer or the playback is not running (stopped or one shot ended)
+ */
+bool AnalogOutputPlaybackQueue(const uint8_t *buffer, uint32_t len);
+
+/**
+ * @brief Stop waveform playback, the DAC keeps the last value.
+ */
+void AnalogOutputPlaybackStop(void);
+
+/**
+ * @brief Check if the playback is running.
+ * 
+ * @return true Playback running
+ * @return false Playback stopped or one shot playback ended
+ */
+bool AnalogOutputPlaybackActive(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
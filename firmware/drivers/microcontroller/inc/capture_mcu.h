@@ -0,0 +1,136 @@
+#ifndef CAPTURE_MCU_H
+#define CAPTURE_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Capture Capture
+ ** @{ */
+
+/** \brief GPIO edge capture (software input capture).
+ *
+ * Both edges of a GPIO input are timestamped in the interruption with the count of the
+ * timers hardware counter (see TimerCount()), and stored in a ring buffer per pin.
+ * From the edges the driver measures period, high time, frequency and duty cycle,
+ * averaged over the last periods, without polling loops.
+ *
+ * Timestamps can be read with CaptureEdges() or consumed with CaptureWaitPulse() (one
+ * consumer per pin). Measurements (CaptureMeasure()) are independent of the ring buffer.
+ *
+ * @note Pulses shorter than the interruption latency (a few us) can be missed. Noisy
+ * inputs should use GPIOInputFilter().
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define CAPTURE_MAX_PINS	4		/*!< Pins captured at once */
+#define CAPTURE_BUF_LEN		32		/*!< Edges stored per pin, power of 2 */
+#define CAPTURE_AVG_MAX		16		/*!< Max periods averaged */
+/*==================[typedef]================================================*/
+/**
+ * @brief Captured edge
+ */
+typedef struct {
+	uint64_t time;			/*!< Timestamp (in us, TimerCount() time base) */
+	bool level;				/*!< Input level after the edge (true: rising edge) */
+} capture_edge_t;
+
+/**
+ * @brief Input measurements, averaged over the last periods
+ */
+typedef struct {
+	uint32_t period;		/*!< Period, rising edge to rising edge (in us) */
+	uint32_t high;			/*!< High time (in us) */
+	float frequency;		/*!< Frequency (in Hz) */
+	float duty;				/*!< Duty cycle (in %) */
+} capture_measure_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Configure a GPIO as input and start capturing both edges
+ *
+ * @param pin GPIO number
+ * @param average Periods averaged by CaptureMeasure() (1 to CAPTURE_AVG_MAX)
+ * @return true Capture started
+ * @return false Not valid pin (GPIO_14 or above GPIO_23) or average, no free capture slot or not enough memory
+ */
+bool CaptureInit(gpio_t pin, uint8_t average);
+
+/**
+ * @brief Stop capturing a GPIO
+ *
+ * @param pin GPIO number
+ */
+void CaptureDeinit(gpio_t pin);
+
+/**
+ * @brief Discard the stored edges
+ *
+ * @param pin GPIO number
+ */
+void CaptureFlush(gpio_t pin);
+
+/**
+ * @brief Read (and remove) the oldest stored edges
+ *
+ * @param pin GPIO number
+ * @param edges Array to store the edges
+ * @param len Max amount of edges to read
+ * @return uint16_t Amount of edges read
+ */
+uint16_t CaptureEdges(gpio_t pin, capture_edge_t *edges, uint16_t len);
+
+/**
+ * @brief Wait (blocking the task) for a whole pulse and measure its width
+ *
+ * Edges stored before the call are also used, call CaptureFlush() first to measure
+ * only new pulses.
+ *
+ * @param pin GPIO number
+ * @param level Pulse level (true: high pulse)
+ * @param start_timeout Max time to wait for the pulse start (in us)
+ * @param max_width Max pulse width (in us), longer pulses are measured as max_width
+ * @param width Pulse width (in us)
+ * @return true Pulse measured
+ * @return false No pulse started before start_timeout
+ */
+bool CaptureWaitPulse(gpio_t pin, bool level, uint32_t start_timeout, uint32_t max_width, uint32_t *width);
+
+/**
+ * @brief Get the input measurements
+ *
+ * The input is considered stopped (no measurements) if there is no rising edge in
+ * 4 periods.
+ *
+ * @param pin GPIO number
+ * @param measure Measurements
+ * @return true Measurements updated
+ * @return false Not enough edges yet or input stopped (measurements set to 0)
+ */
+bool CaptureMeasure(gpio_t pin, capture_measure_t *measure);
+
+/**
+ * @brief Get the amount of edges lost because the buffer was full
+ *
+ * @param pin GPIO number
+ * @return uint32_t Lost edges
+ */
+uint32_t CaptureOverruns(gpio_t pin);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef CAPTURE_MCU_H */
+
+/*==================[end of file]============================================*/
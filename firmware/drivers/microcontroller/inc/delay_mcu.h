@@ -9,10 +9,19 @@
 
 /** \brief Functions to generate delays.
  *
- * This driver provide functions to generate delays FreeRTOS friendly, using one timer.
+ * This driver provide functions to generate delays FreeRTOS friendly.
+ * 
+ * DelaySec() and DelayMs() over 100 ms use vTaskDelay().
+ * 
+ * Short delays (DelayUs() and DelayMs() up to 100 ms) use esp_timer (tickless friendly):
+ * each task gets a wait slot (timer and semaphore) the first time it calls them, which is
+ * kept for the next calls. The task sleeps until shortly before the end of the delay and
+ * busy waits the rest, so the delay is accurate and the CPU is free most of the time.
  * 
  * @note All delays will block the current RTOS task, with the exception of 
- * DelayUs with usec < 50.
+ * DelayUs with usec < 80 (< 40 with CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD),
+ * delays from an ISR and delays of a task without a free slot (or whose timer fails to
+ * start), which busy wait.
  *
  * @author Albano Peñalva
  *
@@ -21,12 +30,16 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Persistent per task wait slots, hybrid sleep/busy wait				|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#ifndef DELAY_SLOTS
+#define DELAY_SLOTS		8		/*!< Tasks that can use sleeping short delays */
+#endif
 
 /*==================[typedef]================================================*/
 
@@ -54,6 +67,12 @@ void DelayMs(uint16_t msec);
  */
 void DelayUs(uint16_t usec);
 
+/**
+ * @brief Free the wait slot of the calling task (call it before deleting a task that used delays)
+ * @return None
+ */
+void DelayRelease(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,99 @@
+#ifndef DISPATCH_MCU_H
+#define DISPATCH_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Dispatch Dispatch
+ ** @{ */
+
+/** \brief Deferred callback dispatcher.
+ *
+ * Interrupts only enqueue a small event (callback and parameter) in a lock-free queue
+ * and wake a single dispatcher task, which runs all the pending callbacks in order.
+ * Callbacks then run as normal task code (any FreeRTOS API can be used, no IRAM needed)
+ * and a project no longer needs one task per event source.
+ *
+ * Timers (timer_config_t.deferred), GPIO interrupts (GPIOActivIntDeferred()) and UART
+ * reception (serial_config_t.deferred) can use the dispatcher. DispatchInit() must be
+ * called before initializing them, deferred timers and GPIO interrupts are rejected otherwise.
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+/*==================[macros]=================================================*/
+#define DISPATCH_QUEUE_LEN		32		/*!< Pending events, power of 2 */
+#define DISPATCH_MAX_QUEUES		4		/*!< FreeRTOS queues served by the dispatcher */
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create the dispatcher task.
+ *
+ * @param priority Dispatcher task priority (callbacks run with this priority)
+ * @return true Dispatcher running
+ * @return false Not enough memory (nothing is left allocated, it can be called again)
+ */
+bool DispatchInit(uint8_t priority);
+
+/**
+ * @brief Check if the dispatcher is running.
+ *
+ * @return true DispatchInit() succeeded
+ */
+bool DispatchReady(void);
+
+/**
+ * @brief Enqueue a callback to be run by the dispatcher task (ISR safe).
+ *
+ * Several interrupts (even nested) can enqueue at once.
+ *
+ * @param func_p Pointer to callback function
+ * @param param_p Pointer to callback function parameter
+ * @return true The dispatcher task was woken, the ISR should yield (return it from a gptimer
+ * callback or use portYIELD_FROM_ISR())
+ */
+bool DispatchFromIsr(void *func_p, void *param_p);
+
+/**
+ * @brief Serve a FreeRTOS queue from the dispatcher task.
+ *
+ * Each time an item arrives to the queue the callback is called, it must read exactly
+ * one item from the queue (without blocking).
+ *
+ * @note The queue must be empty when added.
+ *
+ * @param queue Queue handle
+ * @param len Queue length (items)
+ * @param func_p Pointer to callback function
+ * @param param_p Pointer to callback function parameter
+ * @return true Queue added
+ * @return false Dispatcher not running or no room for more queues
+ */
+bool DispatchAddQueue(QueueHandle_t queue, uint16_t len, void *func_p, void *param_p);
+
+/**
+ * @brief Get the amount of events lost because the queue was full.
+ *
+ * @return uint32_t Lost events
+ */
+uint32_t DispatchOverruns(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DISPATCH_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -26,6 +26,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Deferred interruption callbacks										|
+ * | 18/10/2026 | GPIOActivIntDeferred() returns false without dispatcher				|
  * 
  **/
 
@@ -134,6 +136,21 @@ bool GPIORead(gpio_t pin);
  */
 void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args);
 
+/**
+ * @brief Configure GPIO input interruption with the callback run by the dispatcher task
+ * 
+ * The interruption only enqueues the callback, it runs later in the dispatcher task
+ * (see dispatch_mcu.h), so it can use any FreeRTOS function. DispatchInit() must be called first.
+ * 
+ * @param pin GPIO number
+ * @param ptr_int_func Pointer to callback function
+ * @param edge true: positive edge - false: negative edge
+ * @param args Pointer to callback function parameter
+ * @return true Interruption configured
+ * @return false Invalid pin or dispatcher not running
+ */
+bool GPIOActivIntDeferred(gpio_t pin, void *ptr_int_func, bool edge, void *args);
+
 /**
  * @brief Configure an input glitch filter to a GPIO
  * 
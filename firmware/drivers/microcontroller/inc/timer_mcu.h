@@ -9,6 +9,17 @@
  ** @{ */
 
 /** \brief Timer driver for the ESP-EDU Board.
+ * 
+ * All the timers are software timers multiplexed on a single hardware timer: running
+ * timers are kept in a min-heap ordered by their next expiration and the hardware alarm
+ * is always programmed to the nearest one. Up to TIMER_MAX timers can be used at once.
+ * 
+ * As all the timers count on the same hardware counter, timers started together with
+ * TimerStartSync() keep their phase relation for as long as they run. TimerDrift()
+ * measures the hardware counter against esp_timer.
+ * 
+ * @note The timers interrupt is not IRAM safe, callbacks are delayed while the flash
+ * cache is disabled (flash writes, e.g. NVS).
  * 
  * @author Albano Peñalva
  *
@@ -17,22 +28,40 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Software timers on one hardware timer, one shot mode					|
+ * | 18/10/2026 | Deferred callbacks through the dispatcher task						|
+ * | 18/10/2026 | Period updates at the next alarm, synchronized start, drift			|
+ * | 18/10/2026 | Hardware count for timestamps											|
+ * | 18/10/2026 | TimerInit() returns false if the timer can't be set up				|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
-
+#ifndef TIMER_MAX
+#define TIMER_MAX	16			/*!< Amount of software timers (up to 127) */
+#endif
 /*==================[typedef]================================================*/
 /**
  * @brief List of available timers in this driver
+ * 
+ * @note Any value lower than TIMER_MAX can be used as timer, e.g. (timer_mcu_t)5
  */
 typedef enum timers {
 	TIMER_A,					/*!< Timer A */
 	TIMER_B,					/*!< Timer B */
 	TIMER_C						/*!< Timer C */
 } timer_mcu_t;
+
+/**
+ * @brief Timer modes
+ */
+typedef enum timer_mode {
+	TIMER_PERIODIC,				/*!< Callback called every period */
+	TIMER_ONE_SHOT				/*!< Callback called once, period after TimerStart() */
+} timer_mode_t;
 /**
  * @brief Timer configuration struct
  */
@@ -41,7 +70,17 @@ typedef struct {
 	uint32_t period;		/*!< Period (in us) */
 	void *func_p;			/*!< Pointer to callback function to call periodically */
 	void *param_p;			/*!< Pointer to callback function parameter */
+	timer_mode_t mode;		/*!< Periodic (default) or one shot */
+	bool deferred;			/*!< true: callback runs in the dispatcher task instead of the ISR (see dispatch_mcu.h) */
 } timer_config_t;
+/**
+ * @brief Drift of the timers against esp_timer
+ */
+typedef struct {
+	int64_t elapsed;		/*!< Time measured by esp_timer since the reference (in us) */
+	int64_t offset;			/*!< Timers count minus esp_timer time since the reference (in us) */
+	int32_t ppm;			/*!< Relative drift (parts per million), positive if the timers run fast */
+} timer_drift_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -51,8 +90,10 @@ typedef struct {
  * @note Timer are stopped after init
  * 
  * @param timer_ini Pointer to timer configuration
+ * @return true Timer initialized
+ * @return false Invalid timer, deferred callback without DispatchInit() or hardware timer not available
  */
-void TimerInit(timer_config_t *timer_ini);
+bool TimerInit(timer_config_t *timer_ini);
 
 /**
  * @brief Start timer count
@@ -88,16 +129,54 @@ void TimerReset(timer_mcu_t timer);
 /**
  * @brief Update timer period
  * 
- * @param period New timer period in us
- *
  * The function will update the timer period for the timer that was previously 
- * configured using TimerInit().
+ * configured using TimerInit(). If the timer is running, the current period ends
+ * as programmed and the new period is used from the next alarm on (no short or
+ * long cycle).
  * 
  * @param timer Timer number
  * @param period Period (in us)
  */
 void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period);
 
+/**
+ * @brief Start a group of timers at the same instant
+ * 
+ * All the timers start a full period (plus their phase) from the same count, so
+ * their alarms stay aligned (e.g. a 1 ms and a 10 ms timer expire together every 10 ms).
+ * Running timers of the group are restarted.
+ * 
+ * @param timer_list Timers to start
+ * @param phase Delay of each timer (in us) added to its first period, NULL for none
+ * @param len Amount of timers
+ */
+void TimerStartSync(const timer_mcu_t *timer_list, const uint32_t *phase, uint8_t len);
+
+/**
+ * @brief Measure the drift of the timers against esp_timer
+ * 
+ * The reference is taken at the first TimerInit() or at the last TimerDriftReset().
+ * 
+ * @param drift Measured drift
+ */
+void TimerDrift(timer_drift_t *drift);
+
+/**
+ * @brief Take a new reference for TimerDrift()
+ */
+void TimerDriftReset(void);
+
+/**
+ * @brief Read the hardware counter shared by all the timers, to timestamp events
+ * in the same time base as the timers
+ * 
+ * @note The first call (or TimerInit()) starts the hardware counter, it must not be
+ * done from an ISR.
+ * 
+ * @return uint64_t Count (in us)
+ */
+uint64_t TimerCount(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -17,11 +17,14 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 02/07/2024 | Document creation		                         						|
+ * | 18/10/2026 | Reception callback run by the dispatcher task							|
+ * | 18/10/2026 | UartInit() returns false if the port is not set up as configured		|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 #define UART_NO_INT	0		/*!< Flag used when no reading interruption is required */
 /*==================[typedef]================================================*/
@@ -40,6 +43,7 @@ typedef struct {
 	uint32_t baud_rate;		/*!< baudrate (bits per second) */
 	void *func_p;			/*!< Pointer to callback function to call when receiving data (= UART_NO_INT if not requiered)*/
 	void *param_p;			/*!< Pointer to callback function parameters */
+	bool deferred;			/*!< true: callback run by the dispatcher task instead of a task per port (see dispatch_mcu.h) */
 } serial_config_t;
 /*==================[external data declaration]==============================*/
 
@@ -48,8 +52,12 @@ typedef struct {
  * @brief Serial port initialization
  * 
  * @param port_config 
+ * @return true Port initialized as configured
+ * @return false The event task could not be created, or deferred was requested and the
+ * dispatcher is not running or has no room for the port (the callback is then run by the
+ * port event task)
  */
-void UartInit(serial_config_t *port_config);
+bool UartInit(serial_config_t *port_config);
 
 /**
  * @brief Read a single byte from serial port
@@ -10,22 +10,76 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
 #include "analog_io_mcu.h"
 #include "driver/gptimer.h"
 #include "driver/sdm.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_continuous.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define ADC_BITWIDTH 		SOC_ADC_DIGI_MAX_BITWIDTH	// 12 bit resolution
 #define ADC_ATTENUATION		ADC_ATTEN_DB_12				// 12dB attenuation (for 0-3,3V ADC range)
+#define PLAYBACK_RESOLUTION_HZ	10000000				// 0.1us playback timer tick
+#define PLAYBACK_MAX_FREC		100000					// 10us between samples
+#define ADC_CH_NUM				4						// CH0 to CH3
+#define CONT_FRAME_LEN			64						// Default samples per channel in a continuous frame
+#define CONT_FRAME_LEN_MAX		256						// Max samples per channel in a continuous frame
+#define CONT_FRAMES_STORED		4						// Frames buffered by the IDF driver pool
+#define CONT_RING_LEN			4						// Frames in the ring, power of 2
+#define ADC_RAW_MAX				((1 << ADC_BITWIDTH) - 1)
+#define CALI_LUT_SHIFT			6						// Calibration table knot every 64 raw counts
+#define CALI_LUT_LEN			((1 << ADC_BITWIDTH) >> CALI_LUT_SHIFT)
+#define CALI_LUT_MASK			((1 << CALI_LUT_SHIFT) - 1)
 /*==================[internal data declaration]==============================*/
 adc_cali_handle_t adc_calibration_single_0, adc_calibration_single_1, adc_calibration_single_2, adc_calibration_single_3;
 adc_oneshot_unit_handle_t adc1_single; 
 adc_continuous_handle_t adc2_cont;
 sdm_channel_handle_t dac = NULL;
 bool adc1_single_used = false;
+gptimer_handle_t playback_timer = NULL;					/*!< Dedicated timer for waveform playback */
+static const uint8_t * volatile playback_buffer;		/*!< Buffer being played */
+static volatile uint32_t playback_len;
+static volatile uint32_t playback_index;
+static const uint8_t * volatile playback_next_buffer;	/*!< Queued buffer, NULL if none */
+static volatile uint32_t playback_next_len;
+static volatile bool playback_active = false;
+static dac_playback_mode_t playback_mode;
+static void (*playback_func_p)(void*);
+static void *playback_param_p;
+static const adc_channel_t adc_channels[ADC_CH_NUM] = {ADC_CHANNEL_0, ADC_CHANNEL_1, ADC_CHANNEL_2, ADC_CHANNEL_3};
+static uint8_t cont_init_mask = 0;						/*!< Channels initialized in continuous mode */
+static uint8_t cont_run_mask = 0;						/*!< Channels in the running scan */
+static uint8_t cont_ch_num = 0;							/*!< Channels in the running scan pattern */
+static int8_t cont_ch_index[ADC_CH_NUM] = {-1, -1, -1, -1};	/*!< Position of each channel in the frame, -1: not scanned */
+static uint32_t cont_sample_frec;						/*!< Sample frequency per channel */
+static uint16_t cont_frame_len = CONT_FRAME_LEN;		/*!< Samples per channel in a frame */
+static uint16_t cont_samples[CONT_RING_LEN][ADC_CH_NUM * CONT_FRAME_LEN_MAX];	/*!< Demultiplexed frames */
+static analog_frame_t cont_ring[CONT_RING_LEN];			/*!< Frame descriptors, single producer (ISR) single consumer */
+static bool cont_frame_ring = false;					/*!< true: the ISR never overwrites pending frames */
+static volatile uint32_t cont_head = 0;					/*!< Frames published, written only by the ISR */
+static volatile uint32_t cont_tail = 0;					/*!< Frames released, written only by the consumer */
+static volatile bool cont_borrowed = false;				/*!< The consumer holds the frame at cont_tail */
+static uint32_t cont_seq = 0;
+static volatile uint32_t cont_overruns = 0;
+static volatile uint8_t cont_high_water = 0;
+static int32_t cont_frame_time;							/*!< Time from the first to the last conversion in a frame (us) */
+static uint16_t deskew_prev[ADC_CH_NUM];				/*!< Last raw sample of each channel in the previous deskewed frame */
+static uint32_t deskew_next_seq = 0;					/*!< Sequence number expected by the deskew stage */
+static bool deskew_started = false;						/*!< deskew_prev holds samples of the running scan */
+static void (*cont_func_p)(void*);
+static analog_frame_func_t cont_frame_func_p;
+static void *cont_param_p;
+static adc_cali_handle_t *adc_calibration[ADC_CH_NUM] = {&adc_calibration_single_0, &adc_calibration_single_1, &adc_calibration_single_2, &adc_calibration_single_3};
+static int16_t cali_lut[ADC_CH_NUM][CALI_LUT_LEN + 1];	/*!< Calibration curve in mV, sampled every 2^CALI_LUT_SHIFT raw counts */
+static uint8_t cali_lut_mask = 0;						/*!< Channels with calibration table */
 /*==================[internal functions declaration]=========================*/
+static bool IRAM_ATTR PlaybackIsr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data);
+static bool IRAM_ATTR ContinuousIsr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+static bool ContinuousConfig(void);
+static void ContinuousReset(void);
+static void CalibrationInit(adc_ch_t channel);
 
 /*==================[internal data definition]===============================*/
 adc_oneshot_unit_init_cfg_t init_config_single = {
@@ -39,6 +93,217 @@ adc_oneshot_chan_cfg_t adc_config_single = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Playback timer ISR, writes one sample and switches buffers at the end.
+ * 
+ * @note sdm_channel_set_pulse_density() and gptimer_stop() can be called from an ISR. The
+ * projects don't enable CONFIG_GPTIMER_ISR_IRAM_SAFE, so the ISR (and the user callback)
+ * doesn't run while the flash cache is disabled, playback stalls during flash writes.
+ * The callback can't report a woken task, so no yield is requested (as with func_p in
+ * continuous mode): a callback waking a task calls portYIELD_FROM_ISR() itself.
+ */
+static bool IRAM_ATTR PlaybackIsr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	sdm_channel_set_pulse_density(dac, (int8_t)(playback_buffer[playback_index] - 128));
+	if(++playback_index < playback_len){
+		return false;
+	}
+	playback_index = 0;
+	if(playback_next_buffer != NULL){
+		playback_len = playback_next_len;
+		playback_buffer = playback_next_buffer;
+		playback_next_buffer = NULL;
+	} else if(playback_mode == DAC_ONE_SHOT){
+		gptimer_stop(timer);
+		playback_active = false;
+	}
+	if(playback_func_p != NULL){
+		playback_func_p(playback_param_p);
+	}
+	return false;
+}
+
+/**
+ * @brief Demultiplex one DMA conversion frame into the sample buffer, one block of
+ * cont_frame_len samples per scanned channel.
+ * 
+ * @param data DMA frame (TYPE2 results)
+ * @param size Frame size in bytes
+ * @param frame Demultiplexed frame
+ */
+static void IRAM_ATTR ContinuousDecode(const uint8_t *data, uint32_t size, uint16_t *frame){
+	const adc_digi_output_data_t *result = (const adc_digi_output_data_t *)data;
+	uint16_t count[ADC_CH_NUM] = {0};
+	for(uint32_t i = 0; i < size / SOC_ADC_DIGI_RESULT_BYTES; i++){
+		// ADC_CHANNEL_n is wired to CHn, so the result channel is also the adc_ch_t
+		uint32_t ch = result[i].type2.channel;
+		if((ch < ADC_CH_NUM) && (cont_ch_index[ch] >= 0) && (count[ch] < cont_frame_len)){
+			frame[cont_ch_index[ch] * cont_frame_len + count[ch]++] = result[i].type2.data;
+		}
+	}
+}
+
+/**
+ * @brief Conversion done ISR, the DMA frame is only valid here so it is decoded right away.
+ */
+static bool IRAM_ATTR ContinuousIsr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	uint32_t head = cont_head;
+	if(cont_frame_ring){
+		uint32_t pending = head - __atomic_load_n(&cont_tail, __ATOMIC_ACQUIRE);
+		if(pending >= CONT_RING_LEN){
+			cont_overruns++;
+			cont_seq++;
+			return false;
+		}
+		if(pending + 1 > cont_high_water){
+			cont_high_water = pending + 1;
+		}
+	}
+	analog_frame_t *frame = &cont_ring[head % CONT_RING_LEN];
+	// The frame ends with this conversion, the ISR latency is small compared to a frame
+	frame->timestamp = esp_timer_get_time() - cont_frame_time;
+	ContinuousDecode(edata->conv_frame_buffer, edata->size, frame->samples);
+	frame->seq = cont_seq++;
+	// Publish only after the frame is complete
+	__atomic_store_n(&cont_head, head + 1, __ATOMIC_RELEASE);
+	if(cont_frame_func_p != NULL){
+		return cont_frame_func_p(frame, cont_param_p);
+	}
+	if(cont_func_p != NULL){
+		cont_func_p(cont_param_p);
+	}
+	return false;
+}
+
+/**
+ * @brief Create the channel calibration curve (if needed) and sample it into the
+ * conversion table. Between knots the curve is linearly interpolated.
+ * 
+ * @param channel Channel selected
+ */
+static void CalibrationInit(adc_ch_t channel){
+	if(*adc_calibration[channel] == NULL){
+		adc_cali_curve_fitting_config_t cali_config = {
+			.unit_id = ADC_UNIT_1,
+			.chan = adc_channels[channel],
+			.atten = ADC_ATTENUATION,
+			.bitwidth = ADC_BITWIDTH,
+		};
+		ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, adc_calibration[channel]));
+	}
+	int voltage;
+	for(uint16_t i = 0; i < CALI_LUT_LEN; i++){
+		adc_cali_raw_to_voltage(*adc_calibration[channel], i << CALI_LUT_SHIFT, &voltage);
+		cali_lut[channel][i] = voltage;
+	}
+	// Last knot is out of the raw range, extrapolate the last segment
+	adc_cali_raw_to_voltage(*adc_calibration[channel], ADC_RAW_MAX, &voltage);
+	int32_t last = cali_lut[channel][CALI_LUT_LEN - 1];
+	cali_lut[channel][CALI_LUT_LEN] = last + (((voltage - last) << CALI_LUT_SHIFT) + (CALI_LUT_MASK / 2)) / CALI_LUT_MASK;
+	cali_lut_mask |= (1 << channel);
+}
+
+/**
+ * @brief Release the continuous driver after a failed configuration, no channel is scanned.
+ */
+static void ContinuousReset(void){
+	if(adc2_cont != NULL){
+		adc_continuous_deinit(adc2_cont);
+		adc2_cont = NULL;
+	}
+	cont_run_mask = 0;
+	cont_ch_num = 0;
+	for(uint8_t ch = 0; ch < ADC_CH_NUM; ch++){
+		cont_ch_index[ch] = -1;
+	}
+}
+
+/**
+ * @brief (Re)build the continuous driver for the channels in cont_run_mask and start it.
+ * 
+ * The frame size of the IDF driver is fixed at handle creation and depends on the amount
+ * of channels, so the handle is recreated every time the scan changes.
+ * 
+ * @return true Driver running (or no channels to scan)
+ * @return false The IDF driver rejected the configuration, the conversion is stopped
+ */
+static bool ContinuousConfig(void){
+	if(adc2_cont != NULL){
+		adc_continuous_stop(adc2_cont);
+		adc_continuous_deinit(adc2_cont);
+		adc2_cont = NULL;
+	}
+	if(cont_run_mask == 0){
+		return true;
+	}
+	adc_digi_pattern_config_t pattern[ADC_CH_NUM];
+	cont_ch_num = 0;
+	for(uint8_t ch = 0; ch < ADC_CH_NUM; ch++){
+		if(cont_run_mask & (1 << ch)){
+			pattern[cont_ch_num].atten = ADC_ATTENUATION;
+			pattern[cont_ch_num].channel = adc_channels[ch];
+			pattern[cont_ch_num].unit = ADC_UNIT_1;
+			pattern[cont_ch_num].bit_width = ADC_BITWIDTH;
+			cont_ch_index[ch] = cont_ch_num++;
+		} else {
+			cont_ch_index[ch] = -1;
+		}
+	}
+	uint32_t sample_frec = cont_sample_frec * cont_ch_num;
+	if(sample_frec < SOC_ADC_SAMPLE_FREQ_THRES_LOW){
+		sample_frec = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+	} else if(sample_frec > SOC_ADC_SAMPLE_FREQ_THRES_HIGH){
+		sample_frec = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+	}
+	float channel_skew = 1000000.0f / sample_frec;
+	cont_frame_time = (int32_t)((cont_frame_len * cont_ch_num - 1) * channel_skew + 0.5f);
+
+	memset(cont_samples, 0, sizeof(cont_samples));
+	for(uint8_t i = 0; i < CONT_RING_LEN; i++){
+		cont_ring[i].samples = cont_samples[i];
+		cont_ring[i].frame_len = cont_frame_len;
+		cont_ring[i].channels = cont_ch_num;
+		cont_ring[i].seq = 0;
+		cont_ring[i].timestamp = 0;
+		cont_ring[i].scan_period = channel_skew * cont_ch_num;
+		cont_ring[i].channel_skew = channel_skew;
+	}
+	deskew_started = false;
+	cont_head = 0;
+	cont_tail = 0;
+	cont_seq = 0;
+	cont_overruns = 0;
+	cont_high_water = 0;
+
+	uint32_t frame_size = cont_frame_len * cont_ch_num * SOC_ADC_DIGI_RESULT_BYTES;
+	adc_continuous_handle_cfg_t handle_config = {
+		.max_store_buf_size = frame_size * CONT_FRAMES_STORED,
+		.conv_frame_size = frame_size,
+		.flags.flush_pool = true,	// frames are consumed in the ISR, never block on the pool
+	};
+	if(adc_continuous_new_handle(&handle_config, &adc2_cont) != ESP_OK){
+		adc2_cont = NULL;
+		ContinuousReset();
+		return false;
+	}
+
+	adc_continuous_config_t adc_config_cont = {
+		.pattern_num = cont_ch_num,
+		.adc_pattern = pattern,
+		.sample_freq_hz = sample_frec,
+		.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+		.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+	};
+	adc_continuous_evt_cbs_t cont_cb = {
+		.on_conv_done = ContinuousIsr,
+	};
+	if((adc_continuous_config(adc2_cont, &adc_config_cont) != ESP_OK) ||
+		(adc_continuous_register_event_callbacks(adc2_cont, &cont_cb, NULL) != ESP_OK) ||
+		(adc_continuous_start(adc2_cont) != ESP_OK)){
+		ContinuousReset();
+		return false;
+	}
+	return true;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -97,22 +362,26 @@ void AnalogInputInit(analog_input_config_t *config){
 					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_3, &adc_calibration_single_3));
 				break;
 			}
+			if(config->input < ADC_CH_NUM){
+				CalibrationInit(config->input);
+			}
 		break;
 		case ADC_CONTINUOUS:
-			switch(config->input){
-				case CH0:
-
-				break;
-				case CH1:
-
-				break;
-				case CH2:
-
-				break;
-				case CH3:
-
+			if(config->input >= ADC_CH_NUM){
 				break;
 			}
+			CalibrationInit(config->input);
+			// Scan parameters are shared, the channel is added to the pattern on AnalogStartContinuous()
+			cont_init_mask |= (1 << config->input);
+			cont_sample_frec = config->sample_frec;
+			cont_frame_len = (config->frame_len == 0) ? CONT_FRAME_LEN : config->frame_len;
+			if(cont_frame_len > CONT_FRAME_LEN_MAX){
+				cont_frame_len = CONT_FRAME_LEN_MAX;
+			}
+			cont_func_p = config->func_p;
+			cont_frame_func_p = config->frame_func_p;
+			cont_param_p = config->param_p;
+			cont_frame_ring = config->frame_ring;
 		break;
 	}
 }
@@ -144,16 +413,135 @@ void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value){
 	}
 }
 
-void AnalogStartContinuous(adc_ch_t channel){
+bool AnalogStartContinuous(adc_ch_t channel){
+	if((channel >= ADC_CH_NUM) || !(cont_init_mask & (1 << channel))){
+		return false;
+	}
+	// The ring is cleared by ContinuousConfig(), not while the consumer holds a frame
+	if(cont_borrowed && !(cont_run_mask & (1 << channel))){
+		return false;
+	}
+	if(cont_run_mask & (1 << channel)){
+		return true;
+	}
+	cont_run_mask |= (1 << channel);
+	return ContinuousConfig();
+}
 
+bool AnalogStopContinuous(adc_ch_t channel){
+	if(channel >= ADC_CH_NUM){
+		return false;
+	}
+	if(!(cont_run_mask & (1 << channel))){
+		return true;
+	}
+	if(cont_borrowed){
+		return false;
+	}
+	cont_run_mask &= ~(1 << channel);
+	return ContinuousConfig();
 }
 
-void AnalogStopContinuous(adc_ch_t channel){
+void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+	if((channel >= ADC_CH_NUM) || (cont_ch_index[channel] < 0)){
+		return;
+	}
+	// Newest frame, the ISR fills the oldest slot next
+	uint32_t last = (__atomic_load_n(&cont_head, __ATOMIC_ACQUIRE) - 1) % CONT_RING_LEN;
+	memcpy(values, &cont_samples[last][cont_ch_index[channel] * cont_frame_len], cont_frame_len * sizeof(uint16_t));
+}
 
+void AnalogInputRawToMv(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint32_t len){
+	if((channel >= ADC_CH_NUM) || !(cali_lut_mask & (1 << channel))){
+		return;
+	}
+	const int16_t *lut = cali_lut[channel];
+	for(uint32_t i = 0; i < len; i++){
+		uint32_t value = (raw[i] > ADC_RAW_MAX) ? ADC_RAW_MAX : raw[i];
+		const int16_t *knot = &lut[value >> CALI_LUT_SHIFT];
+		int32_t delta = (knot[1] - knot[0]) * (int32_t)(value & CALI_LUT_MASK);
+		mv[i] = knot[0] + ((delta + (1 << (CALI_LUT_SHIFT - 1))) >> CALI_LUT_SHIFT);
+	}
 }
 
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+void AnalogInputRawToVolts(adc_ch_t channel, const uint16_t *raw, float *volts, uint32_t len){
+	if((channel >= ADC_CH_NUM) || !(cali_lut_mask & (1 << channel))){
+		return;
+	}
+	const int16_t *lut = cali_lut[channel];
+	const float step = 1.0f / (1 << CALI_LUT_SHIFT);
+	for(uint32_t i = 0; i < len; i++){
+		uint32_t value = (raw[i] > ADC_RAW_MAX) ? ADC_RAW_MAX : raw[i];
+		const int16_t *knot = &lut[value >> CALI_LUT_SHIFT];
+		float mv = knot[0] + (knot[1] - knot[0]) * (float)(value & CALI_LUT_MASK) * step;
+		volts[i] = mv * 0.001f;
+	}
+}
 
+analog_frame_t* AnalogInputFrameBorrow(void){
+	uint32_t tail = cont_tail;
+	if(!cont_frame_ring || (tail == __atomic_load_n(&cont_head, __ATOMIC_ACQUIRE))){
+		return NULL;
+	}
+	cont_borrowed = true;
+	return &cont_ring[tail % CONT_RING_LEN];
+}
+
+void AnalogInputFrameRelease(void){
+	uint32_t tail = cont_tail;
+	if(tail != __atomic_load_n(&cont_head, __ATOMIC_ACQUIRE)){
+		__atomic_store_n(&cont_tail, tail + 1, __ATOMIC_RELEASE);
+	}
+	cont_borrowed = false;
+}
+
+uint16_t* AnalogInputFrameChannel(analog_frame_t *frame, adc_ch_t channel){
+	if((frame == NULL) || (channel >= ADC_CH_NUM) || (cont_ch_index[channel] < 0)){
+		return NULL;
+	}
+	return &frame->samples[cont_ch_index[channel] * frame->frame_len];
+}
+
+int64_t AnalogInputFrameScanTime(const analog_frame_t *frame, uint16_t scan){
+	return frame->timestamp + (int64_t)(scan * frame->scan_period + 0.5f);
+}
+
+void AnalogInputFrameDeskew(analog_frame_t *frame){
+	if(frame == NULL){
+		return;
+	}
+	// Channel at position k is sampled k/channels of a scan period late: move it back
+	// towards the previous scan, y[n] = ((channels - k) * x[n] + k * x[n - 1]) / channels
+	int32_t channels = frame->channels;
+	bool contiguous = deskew_started && (frame->seq == deskew_next_seq);
+	for(uint8_t ch = 0; ch < ADC_CH_NUM; ch++){
+		int32_t k = cont_ch_index[ch];
+		if(k < 0){
+			continue;
+		}
+		uint16_t *x = &frame->samples[k * frame->frame_len];
+		uint16_t last = x[frame->frame_len - 1];
+		if(k > 0){
+			for(uint16_t n = frame->frame_len - 1; n > 0; n--){
+				x[n] = ((channels - k) * x[n] + k * x[n - 1] + channels / 2) / channels;
+			}
+			// After a gap there is no previous sample, keep the first one as is
+			if(contiguous){
+				x[0] = ((channels - k) * x[0] + k * deskew_prev[ch] + channels / 2) / channels;
+			}
+		}
+		deskew_prev[ch] = last;
+	}
+	deskew_next_seq = frame->seq + 1;
+	deskew_started = true;
+}
+
+void AnalogInputFrameStats(analog_frame_stats_t *stats){
+	uint32_t head = __atomic_load_n(&cont_head, __ATOMIC_ACQUIRE);
+	stats->frames = head;
+	stats->overruns = cont_overruns;
+	stats->pending = cont_frame_ring ? (head - cont_tail) : 0;
+	stats->high_water = cont_high_water;
 }
 
 void AnalogOutputWrite(uint8_t value){
@@ -161,6 +549,79 @@ void AnalogOutputWrite(uint8_t value){
 	sdm_channel_set_pulse_density(dac, density);
 }
 
+uint32_t AnalogOutputPlaybackStart(analog_output_playback_t *config){
+	if((config->buffer == NULL) || (config->len == 0) || (config->sample_frec == 0) || (config->sample_frec > PLAYBACK_MAX_FREC)){
+		return 0;
+	}
+	if(dac == NULL){
+		AnalogOutputInit();
+	}
+	if(playback_timer == NULL){
+		gptimer_config_t timer_config = {
+			.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+			.direction = GPTIMER_COUNT_UP,
+			.resolution_hz = PLAYBACK_RESOLUTION_HZ,
+		};
+		if(gptimer_new_timer(&timer_config, &playback_timer) != ESP_OK){
+			playback_timer = NULL;
+			return 0;
+		}
+		gptimer_event_callbacks_t playback_cb = {
+			.on_alarm = PlaybackIsr,
+		};
+		gptimer_register_event_callbacks(playback_timer, &playback_cb, NULL);
+		gptimer_enable(playback_timer);
+	}
+	AnalogOutputPlaybackStop();
+	playback_buffer = config->buffer;
+	playback_len = config->len;
+	playback_index = 0;
+	playback_next_buffer = NULL;
+	playback_mode = config->mode;
+	playback_func_p = config->func_p;
+	playback_param_p = config->param_p;
+
+	// Period rounded to the nearest timer tick
+	uint32_t period = (PLAYBACK_RESOLUTION_HZ + config->sample_frec / 2) / config->sample_frec;
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = period,
+		.reload_count = 0,
+		.flags.auto_reload_on_alarm = true,
+	};
+	gptimer_set_alarm_action(playback_timer, &alarm_config);
+	gptimer_set_raw_count(playback_timer, 0);
+	playback_active = true;
+	gptimer_start(playback_timer);
+	return (PLAYBACK_RESOLUTION_HZ + period / 2) / period;
+}
+
+bool AnalogOutputPlaybackQueue(const uint8_t *buffer, uint32_t len){
+	if((buffer == NULL) || (len == 0) || !playback_active || (playback_next_buffer != NULL)){
+		return false;
+	}
+	// Length first, the ISR takes the buffer pointer as the "queued" flag
+	playback_next_len = len;
+	playback_next_buffer = buffer;
+	// A one shot playback may have ended meanwhile, the buffer would never be played
+	if(!playback_active){
+		playback_next_buffer = NULL;
+		return false;
+	}
+	return true;
+}
+
+void AnalogOutputPlaybackStop(void){
+	if(playback_active){
+		playback_active = false;
+		gptimer_stop(playback_timer);
+	}
+	playback_next_buffer = NULL;
+}
+
+bool AnalogOutputPlaybackActive(void){
+	return playback_active;
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,261 @@
+/**
+ * @file capture_mcu.c
+ * @brief GPIO edge capture
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "capture_mcu.h"
+#include "timer_mcu.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define CAPTURE_BUF_MASK		(CAPTURE_BUF_LEN - 1)
+#define CAPTURE_STALE_PERIODS	4		/*!< Periods without rising edge to consider the input stopped */
+#define GPIO_QTY				24
+/*==================[internal data declaration]==============================*/
+typedef struct {
+	gpio_t pin;
+	bool used;
+	capture_edge_t edges[CAPTURE_BUF_LEN];
+	uint32_t head;						/*!< Next edge to write, only the ISR */
+	uint32_t tail;						/*!< Next edge to read, only the consumer */
+	uint32_t overruns;
+	SemaphoreHandle_t edge_sem;			/*!< Given on every edge */
+	uint8_t average;
+	bool level;							/*!< Level after the last edge */
+	bool rise_valid;					/*!< last_rise belongs to the current run of the input */
+	uint64_t last_rise;
+	uint64_t last_fall;
+	uint32_t periods[CAPTURE_AVG_MAX];	/*!< Last periods, circular */
+	uint32_t highs[CAPTURE_AVG_MAX];	/*!< High time of each period */
+	uint8_t avg_pos;
+	uint8_t avg_len;
+} capture_t;
+
+static capture_t captures[CAPTURE_MAX_PINS];
+static uint8_t capture_slot[GPIO_QTY];		/*!< Slot + 1 of each pin, 0 if not captured */
+static portMUX_TYPE capture_lock = portMUX_INITIALIZER_UNLOCKED;
+/*==================[internal functions declaration]=========================*/
+static void CaptureIsr(void *args);
+static capture_t *CaptureGet(gpio_t pin);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static capture_t *CaptureGet(gpio_t pin){
+	if((pin >= GPIO_QTY) || (capture_slot[pin] == 0)){
+		return NULL;
+	}
+	return &captures[capture_slot[pin] - 1];
+}
+
+/**
+ * @brief Timestamp the edge, store it and update the period measurements.
+ */
+static void CaptureIsr(void *args){
+	capture_t *cap = args;
+	uint64_t now = TimerCount();
+	bool level = gpio_get_level((gpio_num_t)cap->pin);
+
+	uint32_t head = cap->head;
+	if((head - __atomic_load_n(&cap->tail, __ATOMIC_ACQUIRE)) < CAPTURE_BUF_LEN){
+		cap->edges[head & CAPTURE_BUF_MASK].time = now;
+		cap->edges[head & CAPTURE_BUF_MASK].level = level;
+		__atomic_store_n(&cap->head, head + 1, __ATOMIC_RELEASE);
+	} else {
+		cap->overruns++;
+	}
+
+	portENTER_CRITICAL_ISR(&capture_lock);
+	if(level){
+		// Whole period (rise, fall, rise) only, a level equal to the previous one means missed edges
+		if(!cap->level && cap->rise_valid && (cap->last_fall > cap->last_rise)){
+			cap->periods[cap->avg_pos] = now - cap->last_rise;
+			cap->highs[cap->avg_pos] = cap->last_fall - cap->last_rise;
+			cap->avg_pos = (cap->avg_pos + 1) % cap->average;
+			if(cap->avg_len < cap->average){
+				cap->avg_len++;
+			}
+		}
+		cap->last_rise = now;
+		cap->rise_valid = true;
+	} else {
+		if(!cap->level){
+			cap->rise_valid = false;
+		}
+		cap->last_fall = now;
+	}
+	cap->level = level;
+	portEXIT_CRITICAL_ISR(&capture_lock);
+
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	xSemaphoreGiveFromISR(cap->edge_sem, &xHigherPriorityTaskWoken);
+	if(xHigherPriorityTaskWoken == pdTRUE){
+		portYIELD_FROM_ISR();
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool CaptureInit(gpio_t pin, uint8_t average){
+	// Same pins as GPIOInit()
+	if((pin == GPIO_14) || (pin > GPIO_23) || (average == 0) || (average > CAPTURE_AVG_MAX)){
+		return false;
+	}
+	CaptureDeinit(pin);
+	capture_t *cap = NULL;
+	uint8_t slot;
+	for(slot = 0; slot < CAPTURE_MAX_PINS; slot++){
+		if(!captures[slot].used){
+			cap = &captures[slot];
+			break;
+		}
+	}
+	if(cap == NULL){
+		return false;
+	}
+	if(cap->edge_sem == NULL){
+		cap->edge_sem = xSemaphoreCreateBinary();
+		if(cap->edge_sem == NULL){
+			return false;
+		}
+	}
+	// Starts the hardware counter before the first interruption
+	TimerCount();
+	cap->pin = pin;
+	cap->used = true;
+	cap->head = 0;
+	cap->tail = 0;
+	cap->overruns = 0;
+	cap->average = average;
+	cap->rise_valid = false;
+	cap->last_rise = 0;
+	cap->last_fall = 0;
+	cap->avg_pos = 0;
+	cap->avg_len = 0;
+	xSemaphoreTake(cap->edge_sem, 0);
+	GPIOInit(pin, GPIO_INPUT);
+	cap->level = GPIORead(pin);
+	capture_slot[pin] = slot + 1;
+	GPIOActivInt(pin, CaptureIsr, true, cap);
+	gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_ANYEDGE);
+	return true;
+}
+
+void CaptureDeinit(gpio_t pin){
+	capture_t *cap = CaptureGet(pin);
+	if(cap == NULL){
+		return;
+	}
+	gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_DISABLE);
+	gpio_isr_handler_remove((gpio_num_t)pin);
+	capture_slot[pin] = 0;
+	// The semaphore is kept for the next pin using the slot
+	cap->used = false;
+}
+
+void CaptureFlush(gpio_t pin){
+	capture_t *cap = CaptureGet(pin);
+	if(cap == NULL){
+		return;
+	}
+	__atomic_store_n(&cap->tail, __atomic_load_n(&cap->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+	xSemaphoreTake(cap->edge_sem, 0);
+}
+
+uint16_t CaptureEdges(gpio_t pin, capture_edge_t *edges, uint16_t len){
+	capture_t *cap = CaptureGet(pin);
+	if(cap == NULL){
+		return 0;
+	}
+	uint32_t head = __atomic_load_n(&cap->head, __ATOMIC_ACQUIRE);
+	uint16_t read = 0;
+	while((cap->tail != head) && (read < len)){
+		edges[read++] = cap->edges[cap->tail & CAPTURE_BUF_MASK];
+		__atomic_store_n(&cap->tail, cap->tail + 1, __ATOMIC_RELEASE);
+	}
+	return read;
+}
+
+bool CaptureWaitPulse(gpio_t pin, bool level, uint32_t start_timeout, uint32_t max_width, uint32_t *width){
+	capture_t *cap = CaptureGet(pin);
+	if(cap == NULL){
+		return false;
+	}
+	uint64_t start = 0;
+	bool started = false;
+	uint64_t deadline = TimerCount() + start_timeout;
+	capture_edge_t edge;
+	while(true){
+		while(CaptureEdges(pin, &edge, 1) == 1){
+			if(!started && (edge.level == level)){
+				start = edge.time;
+				started = true;
+				deadline = start + max_width;
+			} else if(started && (edge.level != level)){
+				uint64_t pulse = edge.time - start;
+				*width = (pulse < max_width) ? pulse : max_width;
+				return true;
+			}
+		}
+		uint64_t now = TimerCount();
+		if(now >= deadline){
+			if(started){
+				*width = max_width;
+			}
+			return started;
+		}
+		// One more tick, the wait is rounded down to whole ticks
+		TickType_t ticks = (deadline - now) / (portTICK_PERIOD_MS * 1000) + 1;
+		xSemaphoreTake(cap->edge_sem, ticks);
+	}
+}
+
+bool CaptureMeasure(gpio_t pin, capture_measure_t *measure){
+	capture_t *cap = CaptureGet(pin);
+	measure->period = 0;
+	measure->high = 0;
+	measure->frequency = 0;
+	measure->duty = 0;
+	if(cap == NULL){
+		return false;
+	}
+	uint64_t period_sum = 0, high_sum = 0;
+	uint8_t len;
+	portENTER_CRITICAL(&capture_lock);
+	uint64_t now = TimerCount();
+	len = cap->avg_len;
+	for(uint8_t i = 0; i < len; i++){
+		period_sum += cap->periods[i];
+		high_sum += cap->highs[i];
+	}
+	if((len > 0) && ((now - cap->last_rise) > CAPTURE_STALE_PERIODS * (period_sum / len))){
+		// Input stopped, start over when it comes back
+		cap->avg_len = 0;
+		cap->avg_pos = 0;
+		cap->rise_valid = false;
+		len = 0;
+	}
+	portEXIT_CRITICAL(&capture_lock);
+	if(len == 0){
+		return false;
+	}
+	measure->period = period_sum / len;
+	measure->high = high_sum / len;
+	measure->frequency = 1000000.0f * len / period_sum;
+	measure->duty = 100.0f * high_sum / period_sum;
+	return true;
+}
+
+uint32_t CaptureOverruns(gpio_t pin){
+	capture_t *cap = CaptureGet(pin);
+	return (cap == NULL) ? 0 : cap->overruns;
+}
+
+/*==================[end of file]============================================*/
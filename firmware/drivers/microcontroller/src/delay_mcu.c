@@ -11,31 +11,121 @@
 
 /*==================[inclusions]=============================================*/
 #include "delay_mcu.h"
-#include "driver/gptimer.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
-#include "esp_rom_sys.h"
 /*==================[macros and definitions]=================================*/
-#define US_RESOLUTION_HZ	1000000	/*!< 1usec */
 #define MSEC				1000	/*!< 1msec = 1000usec */
 #define SEC					1000000	/*!< 1sec = 1000msec */
-#define MIN_US				50	    /*!< minimun delay in usec to use gptimer */
 #define MIN_MS				100	    /*!< minimun delay in msec to use vTaskDelay */
+#ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+#define WAKE_LEAD_US		20		/*!< The task is woken this earlier (ISR latency + context switch) and spins the rest */
+#define MIN_SLEEP_US		40		/*!< Shorter delays only spin */
+#else
+#define WAKE_LEAD_US		50		/*!< The task is woken this earlier (esp_timer task + context switch) and spins the rest */
+#define MIN_SLEEP_US		80		/*!< Shorter delays only spin */
+#endif
 /*==================[internal data declaration]==============================*/
-SemaphoreHandle_t xDelaySemaphore = NULL;
+/**
+ * @brief Wait slot, one per task using the delays (kept for the next calls)
+ */
+typedef struct {
+	TaskHandle_t owner;				/*!< Task using the slot, NULL if free */
+	esp_timer_handle_t timer;		/*!< One shot timer of the slot */
+	SemaphoreHandle_t done;			/*!< Given when the timer expires */
+} delay_slot_t;
+
+static delay_slot_t slots[DELAY_SLOTS];
+static portMUX_TYPE slots_lock = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
-static bool IRAM_ATTR delay_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	gptimer_stop(timer);
-	xSemaphoreGiveFromISR(xDelaySemaphore, &xHigherPriorityTaskWoken);
-	return (xHigherPriorityTaskWoken == pdTRUE);
-}
+static void IRAM_ATTR DelayExpired(void *arg);
+static delay_slot_t *DelaySlot(void);
+static void DelayWait(uint32_t usec);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void IRAM_ATTR DelayExpired(void *arg){
+	delay_slot_t *slot = arg;
+#ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	xSemaphoreGiveFromISR(slot->done, &xHigherPriorityTaskWoken);
+	if(xHigherPriorityTaskWoken == pdTRUE){
+		esp_timer_isr_dispatch_need_yield();
+	}
+#else
+	xSemaphoreGive(slot->done);
+#endif
+}
+
+/**
+ * @brief Get the wait slot of the calling task, the first call of each task takes a free one.
+ *
+ * @return delay_slot_t* Slot, NULL if there are no free slots
+ */
+static delay_slot_t *DelaySlot(void){
+	TaskHandle_t task = xTaskGetCurrentTaskHandle();
+	delay_slot_t *slot = NULL;
+	portENTER_CRITICAL(&slots_lock);
+	for(uint8_t i = 0; i < DELAY_SLOTS; i++){
+		if(slots[i].owner == task){
+			slot = &slots[i];
+			break;
+		}
+	}
+	if(slot == NULL){
+		for(uint8_t i = 0; i < DELAY_SLOTS; i++){
+			if(slots[i].owner == NULL){
+				slots[i].owner = task;
+				slot = &slots[i];
+				break;
+			}
+		}
+	}
+	portEXIT_CRITICAL(&slots_lock);
+	// Only the owner uses the slot, resources are created out of the lock
+	if((slot != NULL) && (slot->timer == NULL)){
+		if(slot->done == NULL){
+			slot->done = xSemaphoreCreateBinary();
+		}
+		esp_timer_create_args_t timer_args = {
+			.callback = DelayExpired,
+			.arg = slot,
+#ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+			.dispatch_method = ESP_TIMER_ISR,
+#else
+			.dispatch_method = ESP_TIMER_TASK,
+#endif
+			.name = "delay",
+			.skip_unhandled_events = true,
+		};
+		if((slot->done == NULL) || (esp_timer_create(&timer_args, &slot->timer) != ESP_OK)){
+			slot->timer = NULL;
+			return NULL;
+		}
+	}
+	return slot;
+}
+
+/**
+ * @brief Hybrid wait: the task sleeps until shortly before the deadline and spins the
+ * rest, so long waits free the CPU and short ones keep their accuracy.
+ */
+static void DelayWait(uint32_t usec){
+	int64_t end = esp_timer_get_time() + usec;
+	if((usec >= MIN_SLEEP_US) && !xPortInIsrContext() &&
+		(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)){
+		delay_slot_t *slot = DelaySlot();
+		// If the timer can't be started the semaphore is never given, busy wait instead
+		if((slot != NULL) && (esp_timer_start_once(slot->timer, usec - WAKE_LEAD_US) == ESP_OK)){
+			xSemaphoreTake(slot->done, portMAX_DELAY);
+		}
+	}
+	while(esp_timer_get_time() < end){
+	}
+}
 
 /*==================[external functions definition]==========================*/
 void DelaySec(uint16_t sec){
@@ -43,73 +133,29 @@ void DelaySec(uint16_t sec){
 }
 
 void DelayMs(uint16_t msec){
-    // If the delay is too short, use the ESP32's internal timer
-    if(msec<=MIN_MS){ 
-        if(xDelaySemaphore == NULL){
-            xDelaySemaphore = xSemaphoreCreateBinary();
-            gptimer_handle_t delay_timer = NULL;
-            gptimer_config_t delay_timer_config = {
-                .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-                .direction = GPTIMER_COUNT_UP,
-                .resolution_hz = US_RESOLUTION_HZ,
-            };
-            gptimer_new_timer(&delay_timer_config, &delay_timer);
-            gptimer_event_callbacks_t delay_alarm = {
-                .on_alarm = delay_isr,
-            };
-            gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-            gptimer_enable(delay_timer);
-            gptimer_alarm_config_t alarm_config = {
-                .alarm_count = msec*MSEC, 
-            };
-            gptimer_set_alarm_action(delay_timer, &alarm_config);
-            gptimer_start(delay_timer);
-            if(xDelaySemaphore != NULL){
-                xSemaphoreTake(xDelaySemaphore, portMAX_DELAY);
-                xDelaySemaphore = NULL;
-            }
-            gptimer_disable(delay_timer);
-            gptimer_del_timer(delay_timer);
-        }
-    }else{       
+    // Short delays are shorter than a few RTOS ticks, use a timer
+    if(msec<=MIN_MS){
+        DelayWait((uint32_t)msec * MSEC);
+    }else{
         // If the delay is longer than the minimum delay, use vTaskDelay
         vTaskDelay(msec / portTICK_PERIOD_MS);
     }
 }
 
 void DelayUs(uint16_t usec){
-    if(usec<=MIN_US){
-        /* If the delay is too short, use the ROM delay function */
-        esp_rom_delay_us(usec);
-    }else{
-        /* If the delay is longer than the minimum, use the ESP32's internal timer */
-        if(xDelaySemaphore == NULL){
-	        xDelaySemaphore = xSemaphoreCreateBinary();
-            gptimer_handle_t delay_timer = NULL;
-            gptimer_config_t delay_timer_config = {
-                .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-                .direction = GPTIMER_COUNT_UP,
-                .resolution_hz = US_RESOLUTION_HZ,
-            };
-            gptimer_new_timer(&delay_timer_config, &delay_timer);
-            gptimer_event_callbacks_t delay_alarm = {
-                .on_alarm = delay_isr,
-            };
-            gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-            gptimer_enable(delay_timer);
-            gptimer_alarm_config_t alarm_config = {
-                .alarm_count = usec, 
-            };
-            gptimer_set_alarm_action(delay_timer, &alarm_config);
-            gptimer_start(delay_timer);
-            if(xDelaySemaphore != NULL){
-                /* Wait for the timer to finish */
-                xSemaphoreTake(xDelaySemaphore, portMAX_DELAY);
-                xDelaySemaphore = NULL;
-            }
-            gptimer_disable(delay_timer);
-            gptimer_del_timer(delay_timer);
-        }
-    }
+    DelayWait(usec);
+}
+
+void DelayRelease(void){
+	TaskHandle_t task = xTaskGetCurrentTaskHandle();
+	portENTER_CRITICAL(&slots_lock);
+	for(uint8_t i = 0; i < DELAY_SLOTS; i++){
+		if(slots[i].owner == task){
+			// Timer and semaphore are kept for the next task taking the slot
+			slots[i].owner = NULL;
+			break;
+		}
+	}
+	portEXIT_CRITICAL(&slots_lock);
 }
 
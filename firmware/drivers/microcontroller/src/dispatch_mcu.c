@@ -0,0 +1,167 @@
+/**
+ * @file dispatch_mcu.c
+ * @brief Deferred callback dispatcher
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dispatch_mcu.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define DISPATCH_STACK_SIZE		4096
+#define DISPATCH_QUEUE_MASK		(DISPATCH_QUEUE_LEN - 1)
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief Queue cell, seq tells producers and consumer whose turn it is (bounded MPMC queue)
+ */
+typedef struct {
+	volatile uint32_t seq;
+	void (*func_p)(void*);
+	void *param_p;
+} dispatch_event_t;
+
+typedef struct {
+	QueueHandle_t queue;
+	void (*func_p)(void*);
+	void *param_p;
+} dispatch_queue_t;
+
+static dispatch_event_t events[DISPATCH_QUEUE_LEN];
+static uint32_t events_head = 0;				/*!< Next cell to write, shared by all the ISRs */
+static uint32_t events_tail = 0;				/*!< Next cell to read, only the dispatcher task */
+static volatile uint32_t overruns = 0;
+static SemaphoreHandle_t events_sem = NULL;		/*!< Given when events are enqueued */
+static QueueSetHandle_t dispatch_set = NULL;
+static dispatch_queue_t queues[DISPATCH_MAX_QUEUES];
+static uint8_t queues_num = 0;
+static TaskHandle_t dispatch_task_handle = NULL;
+/*==================[internal functions declaration]=========================*/
+static void DispatchTask(void *param);
+static void DispatchEvents(void);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Run every pending event, in the order they were enqueued.
+ */
+static void DispatchEvents(void){
+	while(true){
+		dispatch_event_t *event = &events[events_tail & DISPATCH_QUEUE_MASK];
+		if(__atomic_load_n(&event->seq, __ATOMIC_ACQUIRE) != events_tail + 1){
+			return;
+		}
+		void (*func_p)(void*) = event->func_p;
+		void *param_p = event->param_p;
+		// Give the cell back to the producers
+		__atomic_store_n(&event->seq, events_tail + DISPATCH_QUEUE_LEN, __ATOMIC_RELEASE);
+		events_tail++;
+		if(func_p != NULL){
+			func_p(param_p);
+		}
+	}
+}
+
+static void DispatchTask(void *param){
+	while(true){
+		QueueSetMemberHandle_t member = xQueueSelectFromSet(dispatch_set, portMAX_DELAY);
+		if(member == events_sem){
+			// Taken before dispatching, events enqueued meanwhile give it again
+			xSemaphoreTake(events_sem, 0);
+			DispatchEvents();
+		} else {
+			for(uint8_t i = 0; i < queues_num; i++){
+				if(member == queues[i].queue){
+					queues[i].func_p(queues[i].param_p);
+					break;
+				}
+			}
+		}
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool DispatchInit(uint8_t priority){
+	if(dispatch_task_handle != NULL){
+		return true;
+	}
+	for(uint32_t i = 0; i < DISPATCH_QUEUE_LEN; i++){
+		events[i].seq = i;
+	}
+	events_sem = xSemaphoreCreateBinary();
+	dispatch_set = xQueueCreateSet(1 + DISPATCH_MAX_QUEUES * DISPATCH_QUEUE_LEN);
+	if((events_sem != NULL) && (dispatch_set != NULL) && (xQueueAddToSet(events_sem, dispatch_set) == pdPASS)){
+		if(xTaskCreate(DispatchTask, "dispatch_task", DISPATCH_STACK_SIZE, NULL, priority, &dispatch_task_handle) == pdPASS){
+			return true;
+		}
+		xQueueRemoveFromSet(events_sem, dispatch_set);
+	}
+	// Free the partial allocations, a later call starts from scratch
+	dispatch_task_handle = NULL;
+	if(events_sem != NULL){
+		vSemaphoreDelete(events_sem);
+		events_sem = NULL;
+	}
+	if(dispatch_set != NULL){
+		vQueueDelete(dispatch_set);
+		dispatch_set = NULL;
+	}
+	return false;
+}
+
+bool DispatchReady(void){
+	return (dispatch_task_handle != NULL);
+}
+
+bool IRAM_ATTR DispatchFromIsr(void *func_p, void *param_p){
+	uint32_t head = __atomic_load_n(&events_head, __ATOMIC_RELAXED);
+	dispatch_event_t *event;
+	while(true){
+		event = &events[head & DISPATCH_QUEUE_MASK];
+		int32_t diff = (int32_t)(__atomic_load_n(&event->seq, __ATOMIC_ACQUIRE) - head);
+		if(diff < 0){
+			overruns++;
+			return false;
+		}
+		// Claim the cell, a nested ISR may have taken it first
+		if((diff == 0) && __atomic_compare_exchange_n(&events_head, &head, head + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+			break;
+		}
+		if(diff > 0){
+			head = __atomic_load_n(&events_head, __ATOMIC_RELAXED);
+		}
+	}
+	event->func_p = func_p;
+	event->param_p = param_p;
+	__atomic_store_n(&event->seq, head + 1, __ATOMIC_RELEASE);
+
+	BaseType_t task_woken = pdFALSE;
+	xSemaphoreGiveFromISR(events_sem, &task_woken);
+	return (task_woken == pdTRUE);
+}
+
+bool DispatchAddQueue(QueueHandle_t queue, uint16_t len, void *func_p, void *param_p){
+	if(!DispatchReady() || (queues_num >= DISPATCH_MAX_QUEUES) || (len > DISPATCH_QUEUE_LEN)){
+		return false;
+	}
+	queues[queues_num].queue = queue;
+	queues[queues_num].func_p = func_p;
+	queues[queues_num].param_p = param_p;
+	if(xQueueAddToSet(queue, dispatch_set) != pdPASS){
+		return false;
+	}
+	queues_num++;
+	return true;
+}
+
+uint32_t DispatchOverruns(void){
+	return overruns;
+}
+
+/*==================[end of file]============================================*/
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include "driver/gpio.h"
 #include "driver/gpio_filter.h"
+#include "dispatch_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_QTY 	24
 #define FILTER_QTY	8
@@ -23,10 +24,14 @@ typedef struct{
 	gpio_pull_mode_t pull;		/*!< GPIO pull-up/pull-down resistor */
 	bool state;					/*!< GPIO output state */
 } digital_io_t;
+typedef struct{
+	void (*func_p)(void*);		/*!< Callback run by the dispatcher task */
+	void *param_p;				/*!< Callback parameter */
+} deferred_int_t;
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
-
+static void IRAM_ATTR GPIODeferredIsr(void *args);
 /*==================[internal data definition]===============================*/
 digital_io_t gpio_list[GPIO_QTY] = {
 	{GPIO_NUM_0, GPIO_MODE_DISABLE, GPIO_PULLUP_ONLY, false}, /* Configuration GPIO0*/
@@ -54,6 +59,7 @@ digital_io_t gpio_list[GPIO_QTY] = {
 	{GPIO_NUM_22, GPIO_MODE_DISABLE, GPIO_PULLUP_ONLY, false}, /* Configuration GPIO22*/
 	{GPIO_NUM_23, GPIO_MODE_DISABLE, GPIO_PULLUP_ONLY, false}, /* Configuration GPIO23*/
 };
+static deferred_int_t deferred_int[GPIO_QTY];
 gpio_flex_glitch_filter_config_t filter_config = {
 	.clk_src = GLITCH_FILTER_CLK_SRC_DEFAULT,
 	.window_width_ns = 700,
@@ -62,6 +68,12 @@ gpio_flex_glitch_filter_config_t filter_config = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void IRAM_ATTR GPIODeferredIsr(void *args){
+	deferred_int_t *deferred = args;
+	if(DispatchFromIsr(deferred->func_p, deferred->param_p)){
+		portYIELD_FROM_ISR();
+	}
+}
 
 /*==================[external functions definition]==========================*/
 void GPIOInit(gpio_t pin, io_t io){
@@ -116,6 +128,16 @@ void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args){
     gpio_isr_handler_add(gpio_list[pin].pin, ptr_int_func, (void *)args);	
 }
 
+bool GPIOActivIntDeferred(gpio_t pin, void *ptr_int_func, bool edge, void *args){
+	if((pin >= GPIO_QTY) || !DispatchReady()){
+		return false;
+	}
+	deferred_int[pin].func_p = ptr_int_func;
+	deferred_int[pin].param_p = args;
+	GPIOActivInt(pin, GPIODeferredIsr, edge, &deferred_int[pin]);
+	return true;
+}
+
 void GPIOInputFilter(gpio_t pin){
 	static uint8_t filter_count = 0;
 	gpio_glitch_filter_handle_t filter;
@@ -11,19 +11,41 @@
 
 /*==================[inclusions]=============================================*/
 #include "timer_mcu.h"
+#include "dispatch_mcu.h"
 #include "driver/gptimer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define US_RESOLUTION_HZ	1000000	/*!< 1usec */
-#define RESET_COUNT_VALUE	0		/*!< Reset timer count to 0 */
+#define TIMER_MIN_LEAD		2		/*!< Timers expiring closer than this (in us) are dispatched right away */
+#define HEAP_NONE			-1		/*!< Heap position of a stopped timer */
+#define HW_NONE				0		/*!< Hardware counter not created */
+#define HW_STARTING			1		/*!< Hardware counter being created by one task */
+#define HW_READY			2		/*!< Hardware counter running */
+#if TIMER_MAX > 127
+#error "TIMER_MAX must be up to 127 (int8_t heap positions)"
+#endif
 /*==================[internal data declaration]==============================*/
-gptimer_handle_t timer_a = NULL;	/*!< Handle for timer A */	
-gptimer_handle_t timer_b = NULL;	/*!< Handle for timer B */			
-gptimer_handle_t timer_c = NULL;	/*!< Handle for timer C */	
+/**
+ * @brief Software timer
+ */
+typedef struct {
+	uint64_t deadline;				/*!< Next expiration (hardware count), only when running */
+	uint32_t period;				/*!< Period (in us) */
+	uint32_t next_period;			/*!< Period from the next alarm on, 0 if unchanged */
+	uint32_t remaining;				/*!< Time to the next expiration when stopped (in us) */
+	timer_mode_t mode;				/*!< Periodic or one shot */
+	bool deferred;					/*!< Callback run by the dispatcher task */
+	void (*func_p)(void*);			/*!< Pointer to the callback function */
+	void *param_p;					/*!< Callback function parameter */
+	int8_t heap_pos;				/*!< Position in the heap, HEAP_NONE if stopped */
+} soft_timer_t;
+
+gptimer_handle_t timer_hw = NULL;	/*!< Handle for the hardware timer shared by all the timers */
 /**
  * @brief Configuration for the timer
- * 
+ *
  * @details The configuration for the timer specifies the clock source,
  *          count direction, and resolution in Hz.
  */
@@ -32,160 +54,366 @@ const gptimer_config_t timer_config = {
     .direction = GPTIMER_COUNT_UP,		/*!< Count up */
     .resolution_hz = US_RESOLUTION_HZ,	/*!< Resolution in Hz */
 };
-void (*timer_a_isr_p)(void*);	        /*!< Pointer to the ISR function for timer A */	
-void (*timer_b_isr_p)(void*);	        /*!< Pointer to the ISR function for timer B */	
-void (*timer_c_isr_p)(void*);	        /*!< Pointer to the ISR function for timer C */	
+static soft_timer_t timers[TIMER_MAX];
+static uint8_t heap[TIMER_MAX];		/*!< Running timers, min-heap on deadline */
+static uint8_t heap_len = 0;
+static uint8_t timer_hw_state = HW_NONE;	/*!< Only the first caller of TimerHwInit() creates the counter */
+static portMUX_TYPE timer_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t drift_count = 0;	/*!< Hardware count at the drift reference */
+static int64_t drift_time = 0;		/*!< esp_timer time at the drift reference */
+/*==================[internal functions declaration]=========================*/
+static bool IRAM_ATTR TimerIsr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data);
+static uint64_t IRAM_ATTR TimerNow(void);
+static void IRAM_ATTR TimerArm(void);
+static void IRAM_ATTR HeapSwap(uint8_t a, uint8_t b);
+static void IRAM_ATTR HeapFix(uint8_t pos);
+static void IRAM_ATTR HeapPush(uint8_t id);
+static void IRAM_ATTR HeapRemove(uint8_t id);
+static void IRAM_ATTR TimerNextPeriod(soft_timer_t *t);
+static void TimerSample(uint64_t *count, int64_t *time);
+static void TimerHwInit(void);
+/*==================[internal data definition]===============================*/
 
+/*==================[external data definition]===============================*/
 
-void *timer_a_user_data;	            /*!< User data for timer A */	
-void *timer_b_user_data;	            /*!< User data for timer B */	
-void *timer_c_user_data;	            /*!< User data for timer C */	
+/*==================[internal functions definition]==========================*/
+static uint64_t IRAM_ATTR TimerNow(void){
+	uint64_t count = 0;
+	gptimer_get_raw_count(timer_hw, &count);
+	return count;
+}
 
-gptimer_alarm_config_t alarm_config_a;  /*!< Configuration for alarm A */
-gptimer_alarm_config_t alarm_config_b;	/*!< Configuration for alarm B */
-gptimer_alarm_config_t alarm_config_c;	/*!< Configuration for alarm C */
-/*==================[internal functions declaration]=========================*/
-static bool IRAM_ATTR timer_a_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_a_isr_p(timer_a_user_data);
-	return true;
+static void IRAM_ATTR HeapSwap(uint8_t a, uint8_t b){
+	uint8_t id = heap[a];
+	heap[a] = heap[b];
+	heap[b] = id;
+	timers[heap[a]].heap_pos = a;
+	timers[heap[b]].heap_pos = b;
 }
-static bool IRAM_ATTR timer_b_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_b_isr_p(timer_b_user_data);
-	return true;
+
+/**
+ * @brief Restore the heap order after the deadline of the timer at pos changed.
+ */
+static void IRAM_ATTR HeapFix(uint8_t pos){
+	while((pos > 0) && (timers[heap[pos]].deadline < timers[heap[(pos - 1) / 2]].deadline)){
+		HeapSwap(pos, (pos - 1) / 2);
+		pos = (pos - 1) / 2;
+	}
+	while(true){
+		uint8_t min = pos;
+		uint8_t left = 2 * pos + 1;
+		uint8_t right = left + 1;
+		if((left < heap_len) && (timers[heap[left]].deadline < timers[heap[min]].deadline)){
+			min = left;
+		}
+		if((right < heap_len) && (timers[heap[right]].deadline < timers[heap[min]].deadline)){
+			min = right;
+		}
+		if(min == pos){
+			break;
+		}
+		HeapSwap(pos, min);
+		pos = min;
+	}
 }
-static bool IRAM_ATTR timer_c_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_c_isr_p(timer_c_user_data);
-	return true;
+
+static void IRAM_ATTR HeapPush(uint8_t id){
+	heap[heap_len] = id;
+	timers[id].heap_pos = heap_len++;
+	HeapFix(heap_len - 1);
 }
-/*==================[internal data definition]===============================*/
 
-/*==================[external data definition]===============================*/
+static void IRAM_ATTR HeapRemove(uint8_t id){
+	uint8_t pos = timers[id].heap_pos;
+	timers[id].heap_pos = HEAP_NONE;
+	if(pos != --heap_len){
+		heap[pos] = heap[heap_len];
+		timers[heap[pos]].heap_pos = pos;
+		HeapFix(pos);
+	}
+}
 
-/*==================[internal functions definition]==========================*/
+/**
+ * @brief Apply a pending period update (at the start of a new period).
+ */
+static void IRAM_ATTR TimerNextPeriod(soft_timer_t *t){
+	if(t->next_period != 0){
+		t->period = t->next_period;
+		t->next_period = 0;
+	}
+}
+
+/**
+ * @brief Read the hardware count and esp_timer at the same instant (esp_timer is read
+ * before and after the count, the mean is used).
+ */
+static void TimerSample(uint64_t *count, int64_t *time){
+	portENTER_CRITICAL(&timer_lock);
+	int64_t before = esp_timer_get_time();
+	*count = TimerNow();
+	int64_t after = esp_timer_get_time();
+	portEXIT_CRITICAL(&timer_lock);
+	*time = (before + after) / 2;
+}
+
+/**
+ * @brief Create and start the free running hardware counter (only the alarm changes).
+ * 
+ * TimerInit() and TimerCount() may call it from several tasks at once: the first one
+ * creates the counter and the others wait until it is running.
+ */
+static void TimerHwInit(void){
+	uint8_t state = HW_NONE;
+	if(!__atomic_compare_exchange_n(&timer_hw_state, &state, HW_STARTING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+		while(__atomic_load_n(&timer_hw_state, __ATOMIC_ACQUIRE) == HW_STARTING){
+			vTaskDelay(1);
+		}
+		return;
+	}
+	for(uint8_t i = 0; i < TIMER_MAX; i++){
+		timers[i].heap_pos = HEAP_NONE;
+	}
+	gptimer_handle_t hw = NULL;
+	if(gptimer_new_timer(&timer_config, &hw) != ESP_OK){
+		__atomic_store_n(&timer_hw_state, HW_NONE, __ATOMIC_RELEASE);
+		return;
+	}
+	gptimer_event_callbacks_t alarm_cb = {
+		.on_alarm = TimerIsr,
+	};
+	gptimer_register_event_callbacks(hw, &alarm_cb, NULL);
+	gptimer_enable(hw);
+	gptimer_start(hw);
+	// Published once running, timer_hw != NULL means ready for the rest of the driver
+	__atomic_store_n(&timer_hw, hw, __ATOMIC_RELEASE);
+	TimerDriftReset();
+	__atomic_store_n(&timer_hw_state, HW_READY, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Program the hardware alarm for the nearest expiration (call with timer_lock taken).
+ */
+static void IRAM_ATTR TimerArm(void){
+	if(heap_len == 0){
+		gptimer_set_alarm_action(timer_hw, NULL);
+		return;
+	}
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = timers[heap[0]].deadline,
+		.flags.auto_reload_on_alarm = false,
+	};
+	gptimer_set_alarm_action(timer_hw, &alarm_config);
+}
+
+/**
+ * @brief Dispatch every expired timer, periodic ones are rescheduled from their own
+ * deadline (no drift) and one shot ones are stopped. Callbacks run without the lock.
+ * 
+ * @note gptimer_get_raw_count() and gptimer_set_alarm_action() are in flash
+ * (CONFIG_GPTIMER_CTRL_FUNC_IN_IRAM is not enabled). That is safe because the interrupt
+ * isn't IRAM safe either (CONFIG_GPTIMER_ISR_IRAM_SAFE), it is held off while the flash
+ * cache is disabled and timers expire late during flash writes.
+ */
+static bool IRAM_ATTR TimerIsr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	bool yield = false;
+	portENTER_CRITICAL_ISR(&timer_lock);
+	uint64_t now = TimerNow();
+	while((heap_len > 0) && (timers[heap[0]].deadline <= now + TIMER_MIN_LEAD)){
+		soft_timer_t *t = &timers[heap[0]];
+		TimerNextPeriod(t);
+		if(t->mode == TIMER_PERIODIC){
+			t->deadline += t->period;
+			// Periods missed (callbacks longer than the period) are skipped
+			while(t->deadline <= now){
+				t->deadline += t->period;
+			}
+			HeapFix(0);
+		} else {
+			HeapRemove(heap[0]);
+			t->remaining = t->period;
+		}
+		void (*func_p)(void*) = t->func_p;
+		void *param_p = t->param_p;
+		bool deferred = t->deferred;
+		portEXIT_CRITICAL_ISR(&timer_lock);
+		if(deferred){
+			yield |= DispatchFromIsr(func_p, param_p);
+		} else {
+			if(func_p != NULL){
+				func_p(param_p);
+			}
+			// The callback may have woken a task
+			yield = true;
+		}
+		portENTER_CRITICAL_ISR(&timer_lock);
+		now = TimerNow();
+	}
+	TimerArm();
+	portEXIT_CRITICAL_ISR(&timer_lock);
+	return yield;
+}
 
 /*==================[external functions definition]==========================*/
-void TimerInit(timer_config_t *timer_ini){
-	switch(timer_ini->timer){
-	 	case TIMER_A:
-			timer_a_isr_p = timer_ini->func_p;
-			timer_a_user_data = timer_ini->param_p;
-	 		gptimer_new_timer(&timer_config, &timer_a);
-			alarm_config_a.alarm_count = timer_ini->period; 
-			alarm_config_a.reload_count = RESET_COUNT_VALUE;
-			alarm_config_a.flags.auto_reload_on_alarm = true;
-			gptimer_set_alarm_action(timer_a, &alarm_config_a);
-			gptimer_event_callbacks_t alarm_a = {
-				.on_alarm = timer_a_isr,
-			};
-			gptimer_register_event_callbacks(timer_a, &alarm_a, NULL);
-			gptimer_enable(timer_a);
-	 	break;
-
-	 	case TIMER_B:
-			timer_b_isr_p = timer_ini->func_p;
-			timer_b_user_data = timer_ini->param_p;
-	 		gptimer_new_timer(&timer_config, &timer_b);
-			alarm_config_b.alarm_count = timer_ini->period; 
-			alarm_config_b.reload_count = RESET_COUNT_VALUE;
-			alarm_config_b.flags.auto_reload_on_alarm = true;
-			gptimer_set_alarm_action(timer_b, &alarm_config_b);
-			gptimer_event_callbacks_t alarm_b = {
-				.on_alarm = timer_b_isr,
-			};
-			gptimer_register_event_callbacks(timer_b, &alarm_b, NULL);
-			gptimer_enable(timer_b);
-	 	break;
-
-	 	case TIMER_C:
-			timer_c_isr_p = timer_ini->func_p;
-			timer_c_user_data = timer_ini->param_p;
-	 		gptimer_new_timer(&timer_config, &timer_c);
-			alarm_config_c.alarm_count = timer_ini->period; 
-			alarm_config_c.reload_count = RESET_COUNT_VALUE;
-			alarm_config_c.flags.auto_reload_on_alarm = true;
-			gptimer_set_alarm_action(timer_c, &alarm_config_c);
-			gptimer_event_callbacks_t alarm_c = {
-				.on_alarm = timer_c_isr,
-			};
-			gptimer_register_event_callbacks(timer_c, &alarm_c, NULL);
-			gptimer_enable(timer_c);
-	 	break;
+bool TimerInit(timer_config_t *timer_ini){
+	if((timer_ini->timer >= TIMER_MAX) || (timer_ini->deferred && !DispatchReady())){
+		return false;
+	}
+	if(timer_hw == NULL){
+		TimerHwInit();
+		if(timer_hw == NULL){
+			return false;
+		}
 	}
+	TimerStop(timer_ini->timer);
+	soft_timer_t *t = &timers[timer_ini->timer];
+	portENTER_CRITICAL(&timer_lock);
+	t->period = (timer_ini->period == 0) ? 1 : timer_ini->period;
+	t->remaining = t->period;
+	t->next_period = 0;
+	t->mode = timer_ini->mode;
+	t->func_p = timer_ini->func_p;
+	t->param_p = timer_ini->param_p;
+	t->deferred = timer_ini->deferred;
+	portEXIT_CRITICAL(&timer_lock);
+	return true;
 }
 
 void TimerStart(timer_mcu_t timer){
-	switch(timer){
-	 	case TIMER_A:
-	 		gptimer_start(timer_a);
-		break;
-	 	case TIMER_B:
-	 		gptimer_start(timer_b);
-		break;
-	 	case TIMER_C:
-	 		gptimer_start(timer_c);
-		break;
+	if((timer >= TIMER_MAX) || (timer_hw == NULL)){
+		return;
+	}
+	soft_timer_t *t = &timers[timer];
+	portENTER_CRITICAL(&timer_lock);
+	if(t->heap_pos == HEAP_NONE){
+		t->deadline = TimerNow() + t->remaining;
+		HeapPush(timer);
+		TimerArm();
 	}
+	portEXIT_CRITICAL(&timer_lock);
 }
 
 uint32_t TimerRead(timer_mcu_t timer){
-	uint64_t raw_count = 0;
-	switch(timer){
-	 	case TIMER_A:
-	 		gptimer_get_raw_count(timer_a, &raw_count);
-	 	break;
-	 	case TIMER_B:
-	 		gptimer_get_raw_count(timer_b, &raw_count);
-	 	break;
-	 	case TIMER_C:
-	 		gptimer_get_raw_count(timer_c, &raw_count);
-	 	break;
+	if((timer >= TIMER_MAX) || (timer_hw == NULL)){
+		return 0;
 	}
-	return raw_count;
+	soft_timer_t *t = &timers[timer];
+	uint32_t elapsed;
+	portENTER_CRITICAL(&timer_lock);
+	if(t->heap_pos == HEAP_NONE){
+		elapsed = t->period - t->remaining;
+	} else {
+		int64_t remaining = t->deadline - TimerNow();
+		if(remaining <= 0){
+			elapsed = t->period;
+		} else {
+			elapsed = (remaining < t->period) ? (t->period - remaining) : 0;
+		}
+	}
+	portEXIT_CRITICAL(&timer_lock);
+	return elapsed;
 }
 
 void TimerStop(timer_mcu_t timer){
-	switch(timer){
-	 	case TIMER_A:
-	 		gptimer_stop(timer_a);
-	 	break;
-	 	case TIMER_B:
-	 		gptimer_stop(timer_b);
-	 	break;
-	 	case TIMER_C:
-	 		gptimer_stop(timer_c);
-	 	break;
+	if((timer >= TIMER_MAX) || (timer_hw == NULL)){
+		return;
+	}
+	soft_timer_t *t = &timers[timer];
+	portENTER_CRITICAL(&timer_lock);
+	if(t->heap_pos != HEAP_NONE){
+		int64_t remaining = t->deadline - TimerNow();
+		t->remaining = (remaining > 0) ? remaining : 1;
+		HeapRemove(timer);
+		TimerArm();
 	}
+	portEXIT_CRITICAL(&timer_lock);
 }
 
 void TimerReset(timer_mcu_t timer){
-	switch(timer){
-	 	case TIMER_A:
-			gptimer_set_raw_count(timer_a, RESET_COUNT_VALUE);
-	 	break;
-	 	case TIMER_B:
-			gptimer_set_raw_count(timer_b, RESET_COUNT_VALUE);
-	 	break;
-	 	case TIMER_C:
-			gptimer_set_raw_count(timer_c, RESET_COUNT_VALUE);
-	 	break;
+	if((timer >= TIMER_MAX) || (timer_hw == NULL)){
+		return;
+	}
+	soft_timer_t *t = &timers[timer];
+	portENTER_CRITICAL(&timer_lock);
+	TimerNextPeriod(t);
+	t->remaining = t->period;
+	if(t->heap_pos != HEAP_NONE){
+		t->deadline = TimerNow() + t->period;
+		HeapFix(t->heap_pos);
+		TimerArm();
 	}
+	portEXIT_CRITICAL(&timer_lock);
 }
 
 void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period){
-	switch(timer){
-	 	case TIMER_A:
-			alarm_config_a.alarm_count = period;
-			gptimer_set_alarm_action(timer_a, &alarm_config_a);
-	 	break;
-	 	case TIMER_B:
-			alarm_config_b.alarm_count = period;
-			gptimer_set_alarm_action(timer_b, &alarm_config_b);
-	 	break;
-	 	case TIMER_C:
-			alarm_config_c.alarm_count = period;
-			gptimer_set_alarm_action(timer_c, &alarm_config_c);
-	 	break;
+	if((timer >= TIMER_MAX) || (timer_hw == NULL)){
+		return;
+	}
+	soft_timer_t *t = &timers[timer];
+	if(period == 0){
+		period = 1;
+	}
+	portENTER_CRITICAL(&timer_lock);
+	if(t->heap_pos != HEAP_NONE){
+		// The alarm already programmed is kept, the new period starts from it
+		t->next_period = period;
+	} else {
+		uint32_t elapsed = t->period - t->remaining;
+		t->remaining = (period > elapsed) ? (period - elapsed) : 1;
+		t->period = period;
+		t->next_period = 0;
+	}
+	portEXIT_CRITICAL(&timer_lock);
+}
+
+void TimerStartSync(const timer_mcu_t *timer_list, const uint32_t *phase, uint8_t len){
+	if(timer_hw == NULL){
+		return;
+	}
+	portENTER_CRITICAL(&timer_lock);
+	// Same count for all the timers of the group
+	uint64_t start = TimerNow();
+	for(uint8_t i = 0; i < len; i++){
+		if(timer_list[i] >= TIMER_MAX){
+			continue;
+		}
+		soft_timer_t *t = &timers[timer_list[i]];
+		TimerNextPeriod(t);
+		t->remaining = t->period;
+		t->deadline = start + t->period + ((phase != NULL) ? phase[i] : 0);
+		if(t->heap_pos == HEAP_NONE){
+			HeapPush(timer_list[i]);
+		} else {
+			HeapFix(t->heap_pos);
+		}
+	}
+	TimerArm();
+	portEXIT_CRITICAL(&timer_lock);
+}
+
+void TimerDrift(timer_drift_t *drift){
+	if(timer_hw == NULL){
+		return;
+	}
+	uint64_t count;
+	int64_t time;
+	TimerSample(&count, &time);
+	drift->elapsed = time - drift_time;
+	drift->offset = (int64_t)(count - drift_count) - drift->elapsed;
+	drift->ppm = (drift->elapsed > 0) ? (int32_t)(drift->offset * 1000000 / drift->elapsed) : 0;
+}
+
+void TimerDriftReset(void){
+	if(timer_hw == NULL){
+		return;
+	}
+	TimerSample(&drift_count, &drift_time);
+}
+
+uint64_t IRAM_ATTR TimerCount(void){
+	if(timer_hw == NULL){
+		TimerHwInit();
 	}
+	return TimerNow();
 }
 
 /*==================[end of file]============================================*/
@@ -14,8 +14,10 @@
 #include "gpio_mcu.h"
 #include "driver/uart.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "freertos/queue.h"
 #include "esp_log.h"
+#include "dispatch_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define UART_CONN_TX        GPIO_18         /*!<  */
 #define UART_CONN_RX        GPIO_19         /*!<  */
@@ -31,12 +33,30 @@ void *uart_conn_user_data;	                /*!<  */
 static QueueHandle_t uart_pc_queue;         /*!<  */
 static QueueHandle_t uart_conn_queue;       /*!<  */
 /*==================[internal functions declaration]=========================*/
-
+static void UartEvent(void *param);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Handle one event of a port served by the dispatcher task
+ * 
+ * @param param Port (uart_mcu_port_t)
+ */
+static void UartEvent(void *param){
+    uart_event_t event;
+    if((uart_mcu_port_t)param == UART_PC){
+        if(xQueueReceive(uart_pc_queue, (void *)&event, 0) && (event.type == UART_DATA)){
+            uart_pc_isr_p(uart_pc_user_data);
+        }
+    } else {
+        if(xQueueReceive(uart_conn_queue, (void *)&event, 0) && (event.type == UART_DATA)){
+            uart_conn_isr_p(uart_conn_user_data);
+        }
+    }
+}
+
 static void uart_pc_event_task(void *pvParameters){
     uart_event_t event;
     uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
@@ -104,7 +124,8 @@ static void uart_conn_event_task(void *pvParameters){
 }
 /*==================[external functions definition]==========================*/
 
-void UartInit(serial_config_t *port_config){
+bool UartInit(serial_config_t *port_config){
+    bool ret = true;
     uart_config_t uart_config = {
         .baud_rate = port_config->baud_rate,
         .data_bits = UART_DATA_8_BITS,
@@ -119,8 +140,19 @@ void UartInit(serial_config_t *port_config){
             uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
             if(port_config->func_p != UART_NO_INT){
                 uart_pc_isr_p = port_config->func_p;
-                uart_pc_queue = port_config->param_p;
-                xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
+                uart_pc_user_data = port_config->param_p;
+                if(port_config->deferred && DispatchReady()){
+                    uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, EVENT_QUEUE_SIZE, &uart_pc_queue, 0);
+                    if(DispatchAddQueue(uart_pc_queue, EVENT_QUEUE_SIZE, UartEvent, (void *)UART_PC)){
+                        break;
+                    }
+                    // No room in the dispatcher, the event task installs the driver again
+                    uart_driver_delete(UART_NUM_0);
+                }
+                ret = !port_config->deferred;
+                if(xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0) != pdPASS){
+                    ret = false;
+                }
             }else{
                 uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
             }
@@ -130,13 +162,25 @@ void UartInit(serial_config_t *port_config){
             uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
             if(port_config->func_p != UART_NO_INT){
                 uart_conn_isr_p = port_config->func_p;
-                uart_conn_queue = port_config->param_p;
-                xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
+                uart_conn_user_data = port_config->param_p;
+                if(port_config->deferred && DispatchReady()){
+                    uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, EVENT_QUEUE_SIZE, &uart_conn_queue, 0);
+                    if(DispatchAddQueue(uart_conn_queue, EVENT_QUEUE_SIZE, UartEvent, (void *)UART_CONNECTOR)){
+                        break;
+                    }
+                    // No room in the dispatcher, the event task installs the driver again
+                    uart_driver_delete(UART_NUM_1);
+                }
+                ret = !port_config->deferred;
+                if(xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL) != pdPASS){
+                    ret = false;
+                }
             }else{
                 uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
             }
             break;
     }
+    return ret;
 }
 
 uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
@@ -37,11 +37,15 @@ extern "C"
 #include "dsps_d_gen.h"
 #include "dsps_h_gen.h"
 #include "dsps_tone_gen.h"
+#include "dsps_nco.h"
 #include "dsps_snr.h"
 #include "dsps_sfdr.h"
+#include "dsps_quality.h"
 
 #include "dsps_fft2r.h"
 #include "dsps_fft4r.h"
+#include "dsps_fft4s.h"
+#include "dsps_fftmr.h"
 #include "dsps_dct.h"
 
 // Matrix operations
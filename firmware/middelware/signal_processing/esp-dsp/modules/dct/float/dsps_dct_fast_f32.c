@@ -0,0 +1,279 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsp_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dsps_dct.h"
+
+// Fast DCT based on one N/2 point complex FFT (Makhoul).
+// All twiddle factors are calculated once by dsps_dct_init_f32 and the
+// transforms use only the N values working buffer of the structure.
+
+esp_err_t dsps_dct_init_f32(dct_f32_t *dct, int N, float *work)
+{
+    if (NULL == dct) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((N < 4) || (N > 65536) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    memset(dct, 0, sizeof(dct_f32_t));
+    int M = N / 2;
+    dct->N = N;
+    dct->w_fft = (float *)malloc(M * 2 * sizeof(float));
+    dct->w_dct = (float *)malloc(N * 2 * sizeof(float));
+    dct->w_dct4 = (float *)malloc(M * 2 * sizeof(float));
+    dct->bitrev = (uint16_t *)malloc(M * sizeof(uint16_t));
+    if (NULL == work) {
+        work = (float *)malloc(N * sizeof(float));
+        dct->use_work = 1;
+    }
+    dct->work = work;
+    if ((NULL == dct->w_fft) || (NULL == dct->w_dct) || (NULL == dct->w_dct4) ||
+            (NULL == dct->bitrev) || (NULL == dct->work)) {
+        dsps_dct_deinit_f32(dct);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int k = 0; k < M; k++) {
+        double a = -2 * M_PI * k / N;
+        dct->w_fft[k * 2 + 0] = (float)cos(a);
+        dct->w_fft[k * 2 + 1] = (float)sin(a);
+        a = -M_PI * (4 * k + 1) / (4.0 * N);
+        dct->w_dct4[k * 2 + 0] = (float)cos(a);
+        dct->w_dct4[k * 2 + 1] = (float)sin(a);
+    }
+    for (int k = 0; k < N; k++) {
+        double a = -M_PI * k / (2.0 * N);
+        dct->w_dct[k * 2 + 0] = (float)cos(a);
+        dct->w_dct[k * 2 + 1] = (float)sin(a);
+    }
+    int bits = dsp_power_of_two(M);
+    for (int i = 0; i < M; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        dct->bitrev[i] = r;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_dct_deinit_f32(dct_f32_t *dct)
+{
+    if (NULL == dct) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    free(dct->w_fft);
+    free(dct->w_dct);
+    free(dct->w_dct4);
+    free(dct->bitrev);
+    if (dct->use_work) {
+        free(dct->work);
+    }
+    memset(dct, 0, sizeof(dct_f32_t));
+    return ESP_OK;
+}
+
+// In place N/2 point complex FFT, forward direction, natural order output
+static void dct_fft_fc32(const dct_f32_t *dct, float *data)
+{
+    int M = dct->N / 2;
+    const uint16_t *rev = dct->bitrev;
+    for (int i = 0; i < M; i++) {
+        int j = rev[i];
+        if (j > i) {
+            float re = data[i * 2];
+            float im = data[i * 2 + 1];
+            data[i * 2] = data[j * 2];
+            data[i * 2 + 1] = data[j * 2 + 1];
+            data[j * 2] = re;
+            data[j * 2 + 1] = im;
+        }
+    }
+    // First stage without multiplications
+    for (int i = 0; i < M; i += 2) {
+        float *a = &data[i * 2];
+        float re = a[2];
+        float im = a[3];
+        a[2] = a[0] - re;
+        a[3] = a[1] - im;
+        a[0] += re;
+        a[1] += im;
+    }
+    const float *w = dct->w_fft;
+    for (int len = 4; len <= M; len <<= 1) {
+        int half = len >> 1;
+        int w_step = (M / half); // exp(-2*pi*i*j/len) = w_fft[j*N/len]
+        for (int j = 0; j < half; j++) {
+            float wr = w[j * w_step * 2];
+            float wi = w[j * w_step * 2 + 1];
+            for (int i = j; i < M; i += len) {
+                float *a = &data[i * 2];
+                float *b = &data[(i + half) * 2];
+                float re = b[0] * wr - b[1] * wi;
+                float im = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - re;
+                b[1] = a[1] - im;
+                a[0] += re;
+                a[1] += im;
+            }
+        }
+    }
+}
+
+esp_err_t dsps_dct2_f32(dct_f32_t *dct, const float *input, float *output)
+{
+    if ((NULL == dct) || (NULL == dct->work)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int N = dct->N;
+    int M = N / 2;
+    float *v = dct->work;
+    // v = [x0, x2, x4, ..., x5, x3, x1], used as N/2 complex values
+    for (int n = 0; n < M; n++) {
+        v[n] = input[2 * n];
+        v[N - 1 - n] = input[2 * n + 1];
+    }
+    dct_fft_fc32(dct, v);
+
+    // Split N/2 complex FFT to N point real FFT and rotate by exp(-pi*i*k/(2*N))
+    output[0] = v[0] + v[1];
+    output[M] = (v[0] - v[1]) * dct->w_dct[M * 2];
+    const float *wf = dct->w_fft;
+    const float *wd = dct->w_dct;
+    for (int k = 1; k < M; k++) {
+        float zr = v[k * 2];
+        float zi = v[k * 2 + 1];
+        float cr = v[(M - k) * 2];
+        float ci = -v[(M - k) * 2 + 1];
+        // E = (Z[k] + conj(Z[M-k]))/2, O = (Z[k] - conj(Z[M-k]))/(2i)
+        float er = 0.5f * (zr + cr);
+        float ei = 0.5f * (zi + ci);
+        float or_ = 0.5f * (zi - ci);
+        float oi = -0.5f * (zr - cr);
+        // V = E + W*O
+        float vr = er + wf[k * 2] * or_ - wf[k * 2 + 1] * oi;
+        float vi = ei + wf[k * 2] * oi + wf[k * 2 + 1] * or_;
+        // T = exp(-pi*i*k/(2*N)) * V
+        output[k] = wd[k * 2] * vr - wd[k * 2 + 1] * vi;
+        output[N - k] = -(wd[k * 2] * vi + wd[k * 2 + 1] * vr);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_dct3_f32(dct_f32_t *dct, const float *input, float *output)
+{
+    if ((NULL == dct) || (NULL == dct->work)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int N = dct->N;
+    int M = N / 2;
+    float *v = dct->work;
+    const float *wf = dct->w_fft;
+    const float *wd = dct->w_dct;
+    for (int k = 0; k < M; k++) {
+        // A = V[k], B = conj(V[M-k]), V[k] = conj(w_dct[k]) * (X[k] - i*X[N-k]), X[N] = 0
+        float xr = input[k];
+        float xi = (k == 0) ? 0 : -input[N - k];
+        float ar = wd[k * 2] * xr + wd[k * 2 + 1] * xi;
+        float ai = wd[k * 2] * xi - wd[k * 2 + 1] * xr;
+        int m = M - k;
+        xr = input[m];
+        xi = -input[N - m];
+        float br = wd[m * 2] * xr + wd[m * 2 + 1] * xi;
+        float bi = -(wd[m * 2] * xi - wd[m * 2 + 1] * xr);
+        // Z = (A + B + i*conj(w_fft[k])*(A - B))/2
+        float dr = ar - br;
+        float di = ai - bi;
+        float tr = wf[k * 2] * dr + wf[k * 2 + 1] * di;
+        float ti = wf[k * 2] * di - wf[k * 2 + 1] * dr;
+        // Store conj(Z) to calculate inverse FFT with forward FFT
+        v[k * 2] = 0.5f * (ar + br - ti);
+        v[k * 2 + 1] = -0.5f * (ai + bi + tr);
+    }
+    dct_fft_fc32(dct, v);
+    // Real values of inverse FFT are v[2n], -v[2n + 1]
+    for (int m = 0; m < M; m++) {
+        output[2 * m] = (m & 1) ? -v[m] : v[m];
+        output[2 * m + 1] = ((N - 1 - m) & 1) ? -v[N - 1 - m] : v[N - 1 - m];
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_dct4_f32(dct_f32_t *dct, const float *input, float *output)
+{
+    if ((NULL == dct) || (NULL == dct->work)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int N = dct->N;
+    int M = N / 2;
+    float *v = dct->work;
+    const float *wd = dct->w_dct;
+    const float *w4 = dct->w_dct4;
+    // v[n] = (x[2n] + i*x[N-1-2n]) * exp(-pi*i*(4n+1)/(4N))
+    for (int n = 0; n < M; n++) {
+        float xr = input[2 * n];
+        float xi = input[N - 1 - 2 * n];
+        v[n * 2] = xr * w4[n * 2] - xi * w4[n * 2 + 1];
+        v[n * 2 + 1] = xr * w4[n * 2 + 1] + xi * w4[n * 2];
+    }
+    dct_fft_fc32(dct, v);
+    // w = V[k] * exp(-pi*i*k/N), y[2k] = Re(w), y[N-1-2k] = -Im(w)
+    for (int k = 0; k < M; k++) {
+        float cr = wd[k * 4];
+        float ci = wd[k * 4 + 1];
+        output[2 * k] = v[k * 2] * cr - v[k * 2 + 1] * ci;
+        output[N - 1 - 2 * k] = -(v[k * 2] * ci + v[k * 2 + 1] * cr);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_dct_batch_f32(dct_f32_t *dct, dct_type_t type, const float *input, float *output, int count)
+{
+    if (NULL == dct) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    esp_err_t (*transform)(dct_f32_t *, const float *, float *);
+    switch (type) {
+    case DCT_TYPE_II:
+        transform = dsps_dct2_f32;
+        break;
+    case DCT_TYPE_III:
+        transform = dsps_dct3_f32;
+        break;
+    case DCT_TYPE_IV:
+        transform = dsps_dct4_f32;
+        break;
+    default:
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int b = 0; b < count; b++) {
+        esp_err_t ret = transform(dct, &input[b * dct->N], &output[b * dct->N]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
@@ -14,6 +14,7 @@
 
 #ifndef _dsps_dct_H_
 #define _dsps_dct_H_
+#include <stdint.h>
 #include "dsp_err.h"
 #include "sdkconfig.h"
 
@@ -87,6 +88,105 @@ esp_err_t dsps_dct_f32_ref(float *data, int N, float *result);
 esp_err_t dsps_dct_inverce_f32_ref(float *data, int N, float *result);
 /**@}*/
 
+/**
+ * @brief DCT types supported by the fast DCT
+ */
+typedef enum dct_type_e {
+    DCT_TYPE_II = 2,    /*!< DCT-II: y[k] = sum(x[n]*cos(pi*(n + 0.5)*k/N))*/
+    DCT_TYPE_III = 3,   /*!< DCT-III: y[n] = x[0]/2 + sum(x[k]*cos(pi*k*(n + 0.5)/N)), k = 1..N-1*/
+    DCT_TYPE_IV = 4,    /*!< DCT-IV: y[k] = sum(x[n]*cos(pi*(n + 0.5)*(k + 0.5)/N))*/
+} dct_type_t;
+
+/**
+ * @brief Data struct of the f32 fast DCT
+ *
+ * This structure is used by the fast DCT internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_dct_init_f32(...) function.
+ * The structure does not depend on the global FFT tables (dsps_fft2r_init_fc32 is not needed).
+ */
+typedef struct dct_f32_s {
+    int         N;          /*!< DCT length, power of two >= 4.*/
+    float      *w_fft;      /*!< exp(-2*pi*i*k/N), k = 0..N/2-1. Real FFT split and N/2 complex FFT twiddles.*/
+    float      *w_dct;      /*!< exp(-pi*i*k/(2*N)), k = 0..N-1. DCT-II/III and DCT-IV post twiddles.*/
+    float      *w_dct4;     /*!< exp(-pi*i*(4*n + 1)/(4*N)), n = 0..N/2-1. DCT-IV pre twiddles.*/
+    uint16_t   *bitrev;     /*!< Bit reverse permutation for the N/2 complex FFT.*/
+    float      *work;       /*!< Working buffer, N values.*/
+    int16_t     use_work;   /*!< The working buffer was allocated by init function.*/
+} dct_f32_t;
+
+/**@{*/
+/**
+ * @brief   initialize structure for fast DCT
+ *
+ * Function allocates and precomputes all twiddle factors for the length N,
+ * so no sin/cos is called by the transforms.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param dct: pointer to dct structure, that must be preallocated
+ * @param N: DCT length, power of two in range [4..65536]
+ * @param work: working buffer with size of N, or NULL to allocate it internally
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dct_init_f32(dct_f32_t *dct, int N, float *work);
+
+/**
+ * @brief   free fast DCT structure
+ *
+ * @param dct: pointer to dct structure, initialized by dsps_dct_init_f32
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dsps_dct_deinit_f32(dct_f32_t *dct);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   fast DCT, unscaled
+ *
+ * DCT-II, DCT-III or DCT-IV of length N, computed with one N/2 complex FFT.
+ * The result of DCT-II is the same as dsps_dct_f32_ref, DCT-III(DCT-II(x)) = x*N/2,
+ * DCT-IV(DCT-IV(x)) = x*N/2.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param dct: pointer to dct structure, initialized by dsps_dct_init_f32
+ * @param[in] input: input array with size of N
+ * @param[out] output: output array with size of N, could be the same as input
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dct2_f32(dct_f32_t *dct, const float *input, float *output);
+esp_err_t dsps_dct3_f32(dct_f32_t *dct, const float *input, float *output);
+esp_err_t dsps_dct4_f32(dct_f32_t *dct, const float *input, float *output);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   batch of fast DCTs
+ *
+ * Calculates count DCTs of length N for consecutive frames:
+ * output[b*N..b*N + N) = DCT(input[b*N..b*N + N)), b = [0..count)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param dct: pointer to dct structure, initialized by dsps_dct_init_f32
+ * @param type: DCT type
+ * @param[in] input: input frames, count*N values
+ * @param[out] output: output frames, count*N values, could be the same as input
+ * @param count: amount of frames
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dct_batch_f32(dct_f32_t *dct, dct_type_t type, const float *input, float *output, int count);
+/**@}*/
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,187 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_dct.h"
+#include "dsps_fft2r.h"
+#include "dsp_tests.h"
+#include <malloc.h>
+
+static const char *TAG = "dsps_dct_fast";
+
+// Double precision references of the unscaled transforms
+static void dct_ref_d(int type, const float *x, double *y, int N)
+{
+    for (int k = 0; k < N; k++) {
+        double sum = 0;
+        for (int n = 0; n < N; n++) {
+            switch (type) {
+            case DCT_TYPE_II:
+                sum += x[n] * cos(M_PI / N * (n + 0.5) * k);
+                break;
+            case DCT_TYPE_III:
+                sum += (n == 0 ? 0.5 : 1.0) * x[n] * cos(M_PI / N * n * (k + 0.5));
+                break;
+            default:
+                sum += x[n] * cos(M_PI / N * (n + 0.5) * (k + 0.5));
+                break;
+            }
+        }
+        y[k] = sum;
+    }
+}
+
+static const int test_sizes[] = {4, 8, 16, 64, 256, 1024};
+
+TEST_CASE("dsps_dct2/3/4_f32 accuracy", "[dsps]")
+{
+    const int max_N = 1024;
+    float *x = (float *)memalign(16, sizeof(float) * max_N);
+    float *y = (float *)memalign(16, sizeof(float) * max_N);
+    float *z = (float *)memalign(16, sizeof(float) * max_N);
+    double *ref = (double *)malloc(sizeof(double) * max_N);
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(z);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    const int types[] = {DCT_TYPE_II, DCT_TYPE_III, DCT_TYPE_IV};
+    for (int s = 0; s < sizeof(test_sizes) / sizeof(int); s++) {
+        int N = test_sizes[s];
+        dct_f32_t dct;
+        TEST_ESP_OK(dsps_dct_init_f32(&dct, N, NULL));
+        for (int i = 0; i < N; i++) {
+            x[i] = (float)(rand() % 2000 - 1000) / 1000.0f;
+        }
+        for (int t = 0; t < 3; t++) {
+            TEST_ESP_OK(dsps_dct_batch_f32(&dct, types[t], x, y, 1));
+            dct_ref_d(types[t], x, ref, N);
+            float max_err = 0;
+            for (int k = 0; k < N; k++) {
+                float err = fabs(y[k] - ref[k]) / N;
+                if (err > max_err) {
+                    max_err = err;
+                }
+            }
+            ESP_LOGI(TAG, "DCT-%s N = %4i, max error = %e", (t == 0) ? "II" : (t == 1) ? "III" : "IV", N, max_err);
+            TEST_ASSERT_MESSAGE(max_err < 2e-6, "Result out of range!");
+        }
+        // Round trips, in place
+        memcpy(y, x, N * sizeof(float));
+        TEST_ESP_OK(dsps_dct2_f32(&dct, y, y));
+        TEST_ESP_OK(dsps_dct3_f32(&dct, y, y));
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5, x[i], y[i] * 2 / N);
+        }
+        memcpy(y, x, N * sizeof(float));
+        TEST_ESP_OK(dsps_dct4_f32(&dct, y, y));
+        TEST_ESP_OK(dsps_dct4_f32(&dct, y, y));
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5, x[i], y[i] * 2 / N);
+        }
+        // DCT-II must be equal to the existing reference implementation
+        dsps_dct_f32_ref(x, N, z);
+        TEST_ESP_OK(dsps_dct2_f32(&dct, x, y));
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5 * N, z[i], y[i]);
+        }
+        TEST_ESP_OK(dsps_dct_deinit_f32(&dct));
+    }
+    dct_f32_t dct;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_dct_init_f32(&dct, 48, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_dct_init_f32(&dct, 2, NULL));
+
+    free(x);
+    free(y);
+    free(z);
+    free(ref);
+}
+
+TEST_CASE("dsps_dct_batch_f32 functionality", "[dsps]")
+{
+    const int N = 32;
+    const int count = 4;
+    float work[N];
+    float *x = (float *)memalign(16, sizeof(float) * N * count);
+    float *y = (float *)memalign(16, sizeof(float) * N * count);
+    float *z = (float *)memalign(16, sizeof(float) * N);
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(z);
+
+    dct_f32_t dct;
+    TEST_ESP_OK(dsps_dct_init_f32(&dct, N, work));
+    for (int i = 0; i < N * count; i++) {
+        x[i] = sinf(0.1f * i) + 0.25f * (i % 7);
+    }
+    TEST_ESP_OK(dsps_dct_batch_f32(&dct, DCT_TYPE_IV, x, y, count));
+    for (int b = 0; b < count; b++) {
+        TEST_ESP_OK(dsps_dct4_f32(&dct, &x[b * N], z));
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_EQUAL_FLOAT(z[i], y[b * N + i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_dct_batch_f32(&dct, 1, x, y, count));
+    TEST_ESP_OK(dsps_dct_deinit_f32(&dct));
+
+    free(x);
+    free(y);
+    free(z);
+}
+
+TEST_CASE("dsps_dct2_f32 benchmark", "[dsps]")
+{
+    esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    TEST_ESP_OK(ret);
+
+    const int max_N = 1024;
+    float *data = (float *)memalign(16, sizeof(float) * max_N * 2);
+    float *out = (float *)memalign(16, sizeof(float) * max_N);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(out);
+
+    for (int s = 2; s < sizeof(test_sizes) / sizeof(int); s++) {
+        int N = test_sizes[s];
+        for (int i = 0 ; i < N ; i++) {
+            data[i] = 2 * sin(M_PI / N * 4 * 2 * i);
+        }
+        dct_f32_t dct;
+        TEST_ESP_OK(dsps_dct_init_f32(&dct, N, NULL));
+
+        unsigned int start_b = xthal_get_ccount();
+        dsps_dct2_f32(&dct, data, out);
+        unsigned int end_b = xthal_get_ccount();
+        unsigned int fast_cycles = end_b - start_b;
+
+        start_b = xthal_get_ccount();
+        dsps_dct_f32(data, N);
+        end_b = xthal_get_ccount();
+        unsigned int fft_cycles = end_b - start_b;
+
+        start_b = xthal_get_ccount();
+        dsps_dct_f32_ref(out, N, data);
+        end_b = xthal_get_ccount();
+        unsigned int ref_cycles = end_b - start_b;
+
+        ESP_LOGI(TAG, "Benchmark N = %5i: dsps_dct2_f32 %8i, dsps_dct_f32 %8i, dsps_dct_f32_ref %10i cycles",
+                 N, fast_cycles, fft_cycles, ref_cycles);
+        TEST_ESP_OK(dsps_dct_deinit_f32(&dct));
+    }
+    dsps_fft2r_deinit_fc32();
+    free(data);
+    free(out);
+}
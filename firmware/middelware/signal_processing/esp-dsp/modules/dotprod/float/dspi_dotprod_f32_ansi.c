@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dspi_dotprod.h"
+#include "dsps_dotprod_f32_unroll.h"
 
 esp_err_t dspi_dotprod_f32_ansi(image2d_t *in_image, image2d_t *filter, float *out_value, int count_x, int count_y)
 {
@@ -36,9 +37,7 @@ esp_err_t dspi_dotprod_f32_ansi(image2d_t *in_image, image2d_t *filter, float *o
 
     float acc = 0;
     for (int y = 0; y < count_y; y++) {
-        for (int x = 0; x < count_x; x++) {
-            acc += i_data[in_image->step_x * x] * f_data[filter->step_x * x];
-        }
+        acc += dsps_dotprod_f32_unroll(i_data, in_image->step_x, f_data, filter->step_x, count_x);
         i_data += i_step;
         f_data += f_step;
     }
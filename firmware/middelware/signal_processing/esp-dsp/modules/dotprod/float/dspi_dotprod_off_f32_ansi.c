@@ -34,14 +34,25 @@ esp_err_t dspi_dotprod_off_f32_ansi(image2d_t *in_image, image2d_t *filter, floa
     int i_step = in_image->stride_x * in_image->step_y;
     int f_step = filter->stride_x * filter->step_y;
 
-    float acc = 0;
+    int i_step_x = in_image->step_x;
+    int f_step_x = filter->step_x;
+
+    // Independent accumulators hide the FPU add latency
+    float acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
     for (int y = 0; y < count_y; y++) {
-        for (int x = 0; x < count_x; x++) {
-            acc += i_data[in_image->step_x * x] * (f_data[filter->step_x * x] + offset);
+        int x = 0;
+        for (; x <= count_x - 4; x += 4) {
+            acc0 += i_data[i_step_x * x] * (f_data[f_step_x * x] + offset);
+            acc1 += i_data[i_step_x * (x + 1)] * (f_data[f_step_x * (x + 1)] + offset);
+            acc2 += i_data[i_step_x * (x + 2)] * (f_data[f_step_x * (x + 2)] + offset);
+            acc3 += i_data[i_step_x * (x + 3)] * (f_data[f_step_x * (x + 3)] + offset);
+        }
+        for (; x < count_x; x++) {
+            acc0 += i_data[i_step_x * x] * (f_data[f_step_x * x] + offset);
         }
         i_data += i_step;
         f_data += f_step;
     }
-    *out_value = acc;
+    *out_value = (acc0 + acc1) + (acc2 + acc3);
     return ESP_OK;
 }
@@ -13,12 +13,31 @@
 // limitations under the License.
 
 #include "dsps_dotprod.h"
+#include "dsps_dotprod_f32_unroll.h"
 
 esp_err_t dsps_dotprod_f32_ansi(const float *src1, const float *src2, float *dest, int len)
 {
-    float acc = 0;
-    for (int i = 0 ; i < len ; i++) {
-        acc += src1[i] * src2[i];
+    float acc;
+    // Common filter tap counts get a fully unrolled kernel
+    switch (len) {
+    case 4:
+        acc = dsps_dotprod_f32_unroll4(src1, 1, src2, 1, 4);
+        break;
+    case 8:
+        acc = dsps_dotprod_f32_unroll4(src1, 1, src2, 1, 8);
+        break;
+    case 16:
+        acc = dsps_dotprod_f32_unroll8(src1, 1, src2, 1, 16);
+        break;
+    case 32:
+        acc = dsps_dotprod_f32_unroll8(src1, 1, src2, 1, 32);
+        break;
+    case 64:
+        acc = dsps_dotprod_f32_unroll8(src1, 1, src2, 1, 64);
+        break;
+    default:
+        acc = dsps_dotprod_f32_unroll(src1, 1, src2, 1, len);
+        break;
     }
     *dest = acc;
     return ESP_OK;
@@ -0,0 +1,84 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_dotprod_f32_unroll_H_
+#define _dsps_dotprod_f32_unroll_H_
+
+// Unrolled float dot product used by the ANSI kernels.
+// Independent accumulators hide the FPU add latency, a single accumulator
+// serializes every iteration on the previous add.
+// With constant step and length the compiler unrolls the loops completely.
+
+static inline float dsps_dotprod_f32_unroll4(const float *src1, int step1, const float *src2, int step2, int len)
+{
+    float acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        acc0 += src1[0] * src2[0];
+        acc1 += src1[step1] * src2[step2];
+        acc2 += src1[2 * step1] * src2[2 * step2];
+        acc3 += src1[3 * step1] * src2[3 * step2];
+        src1 += 4 * step1;
+        src2 += 4 * step2;
+    }
+    for (; i < len; i++) {
+        acc0 += src1[0] * src2[0];
+        src1 += step1;
+        src2 += step2;
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+static inline float dsps_dotprod_f32_unroll8(const float *src1, int step1, const float *src2, int step2, int len)
+{
+    float acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    float acc4 = 0, acc5 = 0, acc6 = 0, acc7 = 0;
+    int i = 0;
+    for (; i <= len - 8; i += 8) {
+        acc0 += src1[0] * src2[0];
+        acc1 += src1[step1] * src2[step2];
+        acc2 += src1[2 * step1] * src2[2 * step2];
+        acc3 += src1[3 * step1] * src2[3 * step2];
+        acc4 += src1[4 * step1] * src2[4 * step2];
+        acc5 += src1[5 * step1] * src2[5 * step2];
+        acc6 += src1[6 * step1] * src2[6 * step2];
+        acc7 += src1[7 * step1] * src2[7 * step2];
+        src1 += 8 * step1;
+        src2 += 8 * step2;
+    }
+    if (i <= len - 4) {
+        acc0 += src1[0] * src2[0];
+        acc1 += src1[step1] * src2[step2];
+        acc2 += src1[2 * step1] * src2[2 * step2];
+        acc3 += src1[3 * step1] * src2[3 * step2];
+        src1 += 4 * step1;
+        src2 += 4 * step2;
+        i += 4;
+    }
+    for (; i < len; i++) {
+        acc4 += src1[0] * src2[0];
+        src1 += step1;
+        src2 += step2;
+    }
+    return ((acc0 + acc4) + (acc1 + acc5)) + ((acc2 + acc6) + (acc3 + acc7));
+}
+
+// Short vectors do not fill 8 accumulators, the reduction would dominate
+static inline float dsps_dotprod_f32_unroll(const float *src1, int step1, const float *src2, int step2, int len)
+{
+    if (len < 16) {
+        return dsps_dotprod_f32_unroll4(src1, step1, src2, step2, len);
+    }
+    return dsps_dotprod_f32_unroll8(src1, step1, src2, step2, len);
+}
+
+#endif // _dsps_dotprod_f32_unroll_H_
@@ -13,13 +13,10 @@
 // limitations under the License.
 
 #include "dsps_dotprod.h"
+#include "dsps_dotprod_f32_unroll.h"
 
 esp_err_t dsps_dotprode_f32_ansi(const float *src1, const float *src2, float *dest, int len, int step1, int step2)
 {
-    float acc = 0;
-    for (int i = 0 ; i < len ; i++) {
-        acc += src1[i * step1] * src2[i * step2];
-    }
-    *dest = acc;
+    *dest = dsps_dotprod_f32_unroll(src1, step1, src2, step2, len);
     return ESP_OK;
 }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string.h>
+#include <math.h>
 #include "unity.h"
 #include "esp_dsp.h"
 #include "dsp_platform.h"
@@ -165,3 +166,79 @@ TEST_CASE("dsps_dotprod_f32_ansi benchmark", "[dsps]")
     free(y);
     free(z);
 }
+
+TEST_CASE("dsps_dotprod_f32_ansi accuracy", "[dsps]")
+{
+    int max_N = 1024;
+    float *x = (float *)malloc(max_N * sizeof(float));
+    float *y = (float *)malloc(max_N * sizeof(float));
+
+    for (int i = 0 ; i < max_N ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5;
+        y[i] = (float)rand() / RAND_MAX - 0.5;
+    }
+    // All specialized lengths and every head/tail combination of the unrolled loops
+    for (int len = 1 ; len <= 80 ; len++) {
+        for (int step = 1 ; step <= 3 ; step++) {
+            double ref = 0;
+            double abs_sum = 0;
+            for (int i = 0 ; i < len ; i++) {
+                ref += (double)x[i * step] * y[i * step];
+                abs_sum += fabs((double)x[i * step] * y[i * step]);
+            }
+            float result = 0;
+            if (step == 1) {
+                TEST_ESP_OK(dsps_dotprod_f32_ansi(x, y, &result, len));
+            } else {
+                TEST_ESP_OK(dsps_dotprode_f32_ansi(x, y, &result, len, step, step));
+            }
+            TEST_ASSERT_MESSAGE(fabs(result - ref) <= abs_sum * 1e-6, "Result out of range!");
+        }
+    }
+
+    free(x);
+    free(y);
+}
+
+TEST_CASE("dsps_dotprod_f32_ansi cycles per element", "[dsps]")
+{
+    int max_N = 1024;
+    float *x = (float *)malloc(max_N * sizeof(float));
+    float *y = (float *)malloc(max_N * sizeof(float));
+    float z = 0;
+    volatile float sink;
+
+    for (int i = 0 ; i < max_N ; i++) {
+        x[i] = 1;
+        y[i] = 1000;
+    }
+
+    // Cycle counts are meaningful on the target only (xthal_get_ccount)
+    const int lengths[] = {4, 8, 15, 16, 32, 64, 100, 256, 1024};
+    for (int l = 0 ; l < sizeof(lengths) / sizeof(lengths[0]) ; l++) {
+        int len = lengths[l];
+        int repeat_count = 16 * 1024 / len;
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0 ; i < repeat_count ; i++) {
+            dsps_dotprod_f32_ansi(x, y, &z, len);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        float cycles = (float)(end_b - start_b) / (repeat_count * len);
+
+        // Single accumulator loop as reference for the unrolled kernels
+        start_b = xthal_get_ccount();
+        for (int i = 0 ; i < repeat_count ; i++) {
+            float acc = 0;
+            for (int n = 0 ; n < len ; n++) {
+                acc += x[n] * y[n];
+            }
+            sink = acc;
+        }
+        end_b = xthal_get_ccount();
+        float cycles_ref = (float)(end_b - start_b) / (repeat_count * len);
+        printf("Benchmark dsps_dotprod_f32_ansi - len %4i: %f cycles per element (single accumulator loop %f).\n", len, cycles, cycles_ref);
+    }
+
+    free(x);
+    free(y);
+}
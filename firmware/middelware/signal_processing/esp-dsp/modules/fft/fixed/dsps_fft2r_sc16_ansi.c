@@ -169,6 +169,115 @@ esp_err_t dsps_fft2r_sc16_ansi_(int16_t *data, int N, int16_t *sc_table)
     return result;
 }
 
+// Block floating point limits. A butterfly output is bounded by |a| + |w*b| <= (1 + sqrt(2)) * max,
+// BFP_MAX_IN keeps a0 * 0x7fff + w * b inside int32, BFP_MAX_SHIFTn is the largest block
+// maximum that still fits into BFP_MAX_IN after a shift by n bits.
+#define BFP_MAX_IN      27145
+#define BFP_MAX_SHIFT0  11243
+#define BFP_MAX_SHIFT1  22487
+
+static inline uint32_t bfp_max(uint32_t max, int32_t x)
+{
+    uint32_t a = x < 0 ? -x : x;
+    return a > max ? a : max;
+}
+
+esp_err_t dsps_fft2r_sc16_bfp_ansi_(int16_t *data, int N, int16_t *sc_table, int *exponent)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (NULL == exponent) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    uint32_t *w = (uint32_t *)sc_table;
+    uint32_t *in_data = (uint32_t *)data;
+    uint32_t max = 0;
+    int exp = 0;
+
+    for (int i = 0; i < N * 2; i++) {
+        max = bfp_max(max, data[i]);
+    }
+    *exponent = 0;
+    if (max == 0) {
+        return ESP_OK;
+    }
+    // Normalize the block, small signals are shifted up to use the whole word
+    if (max > BFP_MAX_IN) {
+        for (int i = 0; i < N * 2; i++) {
+            data[i] >>= 1;
+        }
+        max >>= 1;
+        exp = 1;
+    } else {
+        while ((max << 1) <= BFP_MAX_IN) {
+            max <<= 1;
+            exp--;
+        }
+        for (int i = 0; i < N * 2; i++) {
+            data[i] = (int16_t)((int32_t)data[i] * (1 << -exp));
+        }
+    }
+
+    int ie, ia, m;
+    sc16_t cs;// c - re, s - im
+    sc16_t m_data;
+    sc16_t a_data;
+
+    ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        // Scale only as much as the headroom of this stage requires
+        int shift = 2;
+        if (max <= BFP_MAX_SHIFT0) {
+            shift = 0;
+        } else if (max <= BFP_MAX_SHIFT1) {
+            shift = 1;
+        }
+        exp += shift;
+        int result_shift = 15 + shift;
+        int32_t round = 1 << (result_shift - 1);
+        max = 0;
+
+        ia = 0;
+        for (int j = 0; j < ie; j++) {
+            cs.data = w[j];
+            for (int i = 0; i < N2; i++) {
+                m = ia + N2;
+                m_data.data = in_data[m];
+                a_data.data = in_data[ia];
+                int32_t t_re = (int32_t)cs.re * m_data.re + (int32_t)cs.im * m_data.im;
+                int32_t t_im = (int32_t)cs.re * m_data.im - (int32_t)cs.im * m_data.re;
+                int32_t a_re = (int32_t)a_data.re * mult_shift_const + round;
+                int32_t a_im = (int32_t)a_data.im * mult_shift_const + round;
+
+                sc16_t m1;
+                m1.re = (int16_t)((a_re - t_re) >> result_shift);
+                m1.im = (int16_t)((a_im - t_im) >> result_shift);
+                in_data[m] = m1.data;
+
+                sc16_t m2;
+                m2.re = (int16_t)((a_re + t_re) >> result_shift);
+                m2.im = (int16_t)((a_im + t_im) >> result_shift);
+                in_data[ia] = m2.data;
+
+                max = bfp_max(max, m1.re);
+                max = bfp_max(max, m1.im);
+                max = bfp_max(max, m2.re);
+                max = bfp_max(max, m2.im);
+                ia++;
+            }
+            ia += N2;
+        }
+        ie <<= 1;
+    }
+    *exponent = exp;
+    return ESP_OK;
+}
+
 
 static inline unsigned short reverse_sc16(unsigned short x, unsigned short N, int order)
 {
@@ -24,9 +24,16 @@
 
 static const char *TAG = "fftr2_ansi";
 
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+// Static tables are ready without dsps_fft2r_init_fc32
+float *dsps_fft_w_table_fc32 = (float *)dsps_fft2r_w_table_static_fc32;
+int dsps_fft_w_table_size = CONFIG_DSP_FFT_STATIC_TABLE_SIZE;
+uint8_t dsps_fft2r_initialized = 1;
+#else
 float *dsps_fft_w_table_fc32;
 int dsps_fft_w_table_size;
 uint8_t dsps_fft2r_initialized = 0;
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
 uint8_t dsps_fft2r_mem_allocated = 0;
 
 uint16_t *dsps_fft2r_ram_rev_table = NULL;
@@ -40,6 +47,24 @@ unsigned short reverse(unsigned short x, unsigned short N, int order);
 esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size)
 {
     esp_err_t result = ESP_OK;
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+    if (dsps_fft_w_table_fc32 == dsps_fft2r_w_table_static_fc32) {
+        // Checked here too, dsps_fft2r_initialized is already set for the static table
+        if (table_size > CONFIG_DSP_MAX_FFT_SIZE) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        // Twiddle table in flash covers all sizes up to CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+        // and the bit reverse tables are used from flash too.
+        if ((fft_table_buff == NULL) && (table_size <= CONFIG_DSP_FFT_STATIC_TABLE_SIZE)) {
+            dsps_fft2r_initialized = 1;
+            return result;
+        }
+        // Bigger table or external buffer requested: initialize it at runtime
+        if ((table_size > 0) && (table_size <= CONFIG_DSP_MAX_FFT_SIZE)) {
+            dsps_fft2r_initialized = 0;
+        }
+    }
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
     if (dsps_fft2r_initialized != 0) {
         return result;
     }
@@ -117,7 +142,13 @@ void dsps_fft2r_deinit_fc32()
     // Re init bitrev table for next use
     dsps_fft2r_rev_tables_init_fc32();
     dsps_fft2r_mem_allocated = 0;
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+    dsps_fft_w_table_fc32 = (float *)dsps_fft2r_w_table_static_fc32;
+    dsps_fft_w_table_size = CONFIG_DSP_FFT_STATIC_TABLE_SIZE;
+    dsps_fft2r_initialized = 1;
+#else
     dsps_fft2r_initialized = 0;
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
 }
 
 esp_err_t dsps_fft2r_fc32_ansi_(float *data, int N, float *w)
@@ -0,0 +1,254 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsps_fft4s.h"
+#include "dsps_fft_tables.h"
+#include "dsp_common.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+float *dsps_fft4s_w_table_fc32 = NULL;
+int dsps_fft4s_w_table_size = 0;
+float *dsps_fft4s_work_fc32 = NULL;
+int dsps_fft4s_max_size = 0;
+uint8_t dsps_fft4s_initialized = 0;
+static float *dsps_fft4s_mem_allocated = NULL;
+
+esp_err_t dsps_fft4s_init_fc32(float *fft_buff, int max_fft_size)
+{
+    if (dsps_fft4s_initialized != 0) {
+        // Tables already cover this size, other buffer or bigger size needs deinit first
+        if ((fft_buff == NULL) && (max_fft_size <= dsps_fft4s_max_size)) {
+            return ESP_OK;
+        }
+        return ESP_ERR_DSP_REINITIALIZED;
+    }
+    if (max_fft_size > CONFIG_DSP_MAX_FFT_SIZE) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((max_fft_size < 2) || !dsp_is_power_of_two(max_fft_size)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+    if (max_fft_size <= CONFIG_DSP_FFT_STATIC_TABLE_SIZE) {
+        // Only the working buffer is required, twiddle factors are in flash
+        if (fft_buff == NULL) {
+            fft_buff = (float *)malloc(max_fft_size * 2 * sizeof(float));
+            if (fft_buff == NULL) {
+                return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+            }
+            dsps_fft4s_mem_allocated = fft_buff;
+        }
+        dsps_fft4s_w_table_fc32 = (float *)dsps_fft4s_w_table_static_fc32;
+        dsps_fft4s_w_table_size = CONFIG_DSP_FFT_STATIC_TABLE_SIZE;
+        dsps_fft4s_work_fc32 = fft_buff;
+        dsps_fft4s_max_size = max_fft_size;
+        dsps_fft4s_initialized = 1;
+        return ESP_OK;
+    }
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+    if (fft_buff == NULL) {
+        fft_buff = (float *)malloc(max_fft_size * 4 * sizeof(float));
+        if (fft_buff == NULL) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        dsps_fft4s_mem_allocated = fft_buff;
+    }
+    dsps_fft4s_w_table_fc32 = fft_buff;
+    dsps_fft4s_w_table_size = max_fft_size;
+    dsps_fft4s_work_fc32 = fft_buff + max_fft_size * 2;
+    dsps_fft4s_max_size = max_fft_size;
+
+    // exp(-2*pi*i*k/max_fft_size)
+    for (int k = 0; k < max_fft_size; k++) {
+        double angle = 2 * M_PI * k / max_fft_size;
+        dsps_fft4s_w_table_fc32[2 * k + 0] = (float)cos(angle);
+        dsps_fft4s_w_table_fc32[2 * k + 1] = (float) - sin(angle);
+    }
+    dsps_fft4s_initialized = 1;
+    return ESP_OK;
+}
+
+void dsps_fft4s_deinit_fc32(void)
+{
+    free(dsps_fft4s_mem_allocated);
+    dsps_fft4s_mem_allocated = NULL;
+    dsps_fft4s_w_table_fc32 = NULL;
+    dsps_fft4s_w_table_size = 0;
+    dsps_fft4s_work_fc32 = NULL;
+    dsps_fft4s_max_size = 0;
+    dsps_fft4s_initialized = 0;
+}
+
+// Radix-4 auto-sort passes of N points transforms.
+// s0 is the distance between samples of one transform (interleaved channels),
+// channel_step is the distance between channel-major transforms (in floats).
+// Twiddle factors are loaded once per butterfly group for all channels.
+static void dsps_fft4s_passes(float *data, float *work, int N, int s0, int channels, int channel_step)
+{
+    const float *w = dsps_fft4s_w_table_fc32;
+    float *x = data;
+    float *y = work;
+    int s = s0;                             // stride of the independent sub-transforms
+    int n = N;                              // length of the current sub-transforms
+    int w_step = dsps_fft4s_w_table_size / N; // exp(-2*pi*i/n) = w[w_step]
+
+    // Radix-4 passes with twiddle factors:
+    // y[q + s*(4p + r)] = W^(p*r) * sum(x[q + s*(p + k*n/4)] * (-i)^(k*r))
+    while (n > 4) {
+        int m = n >> 2;
+        for (int p = 0; p < m; p++) {
+            float w1r = w[2 * p * w_step];
+            float w1i = w[2 * p * w_step + 1];
+            float w2r = w[4 * p * w_step];
+            float w2i = w[4 * p * w_step + 1];
+            float w3r = w[6 * p * w_step];
+            float w3i = w[6 * p * w_step + 1];
+            for (int c = 0; c < channels; c++) {
+                const float *xp = &x[c * channel_step + 2 * s * p];
+                float *yp = &y[c * channel_step + 2 * s * 4 * p];
+                for (int q = 0; q < s * 2; q += 2) {
+                    float ar = xp[q];
+                    float ai = xp[q + 1];
+                    float br = xp[q + 2 * s * m];
+                    float bi = xp[q + 2 * s * m + 1];
+                    float cr = xp[q + 4 * s * m];
+                    float ci = xp[q + 4 * s * m + 1];
+                    float dr = xp[q + 6 * s * m];
+                    float di = xp[q + 6 * s * m + 1];
+
+                    float apc_r = ar + cr;
+                    float apc_i = ai + ci;
+                    float amc_r = ar - cr;
+                    float amc_i = ai - ci;
+                    float bpd_r = br + dr;
+                    float bpd_i = bi + di;
+                    // i*(b - d)
+                    float jbmd_r = di - bi;
+                    float jbmd_i = br - dr;
+
+                    yp[q] = apc_r + bpd_r;
+                    yp[q + 1] = apc_i + bpd_i;
+
+                    float tr = amc_r - jbmd_r;
+                    float ti = amc_i - jbmd_i;
+                    yp[q + 2 * s] = tr * w1r - ti * w1i;
+                    yp[q + 2 * s + 1] = tr * w1i + ti * w1r;
+
+                    tr = apc_r - bpd_r;
+                    ti = apc_i - bpd_i;
+                    yp[q + 4 * s] = tr * w2r - ti * w2i;
+                    yp[q + 4 * s + 1] = tr * w2i + ti * w2r;
+
+                    tr = amc_r + jbmd_r;
+                    ti = amc_i + jbmd_i;
+                    yp[q + 6 * s] = tr * w3r - ti * w3i;
+                    yp[q + 6 * s + 1] = tr * w3i + ti * w3r;
+                }
+            }
+        }
+        float *t = x;
+        x = y;
+        y = t;
+        s <<= 2;
+        n >>= 2;
+        w_step <<= 2;
+    }
+
+    // Last pass has no twiddle factors and reads and writes the same
+    // positions, so it is done from the current buffer into data.
+    for (int c = 0; c < channels; c++) {
+        const float *xc = &x[c * channel_step];
+        float *dc = &data[c * channel_step];
+        if (n == 4) {
+            for (int q = 0; q < s * 2; q += 2) {
+                float ar = xc[q];
+                float ai = xc[q + 1];
+                float br = xc[q + 2 * s];
+                float bi = xc[q + 2 * s + 1];
+                float cr = xc[q + 4 * s];
+                float ci = xc[q + 4 * s + 1];
+                float dr = xc[q + 6 * s];
+                float di = xc[q + 6 * s + 1];
+
+                float apc_r = ar + cr;
+                float apc_i = ai + ci;
+                float amc_r = ar - cr;
+                float amc_i = ai - ci;
+                float bpd_r = br + dr;
+                float bpd_i = bi + di;
+                float jbmd_r = di - bi;
+                float jbmd_i = br - dr;
+
+                dc[q] = apc_r + bpd_r;
+                dc[q + 1] = apc_i + bpd_i;
+                dc[q + 2 * s] = amc_r - jbmd_r;
+                dc[q + 2 * s + 1] = amc_i - jbmd_i;
+                dc[q + 4 * s] = apc_r - bpd_r;
+                dc[q + 4 * s + 1] = apc_i - bpd_i;
+                dc[q + 6 * s] = amc_r + jbmd_r;
+                dc[q + 6 * s + 1] = amc_i + jbmd_i;
+            }
+        } else {
+            for (int q = 0; q < s * 2; q += 2) {
+                float ar = xc[q];
+                float ai = xc[q + 1];
+                float br = xc[q + 2 * s];
+                float bi = xc[q + 2 * s + 1];
+                dc[q] = ar + br;
+                dc[q + 1] = ai + bi;
+                dc[q + 2 * s] = ar - br;
+                dc[q + 2 * s + 1] = ai - bi;
+            }
+        }
+    }
+}
+
+esp_err_t dsps_fft4s_fc32_ansi(float *data, int N)
+{
+    if (0 == dsps_fft4s_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((N < 2) || (N > dsps_fft4s_max_size) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    dsps_fft4s_passes(data, dsps_fft4s_work_fc32, N, 1, 1, 0);
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft4s_batch_fc32_ansi(float *data, int N, int channels, dsps_fft_layout_t layout, float *work)
+{
+    if (0 == dsps_fft4s_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((N < 2) || (N > dsps_fft4s_max_size) || !dsp_is_power_of_two(N) || (channels < 1)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (NULL == data) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == work) {
+        if (N * channels > dsps_fft4s_max_size) {
+            return ESP_ERR_DSP_INVALID_LENGTH;
+        }
+        work = dsps_fft4s_work_fc32;
+    }
+    if (layout == DSPS_FFT_INTERLEAVED) {
+        // Channels are the fastest sub-transforms index of the first pass
+        dsps_fft4s_passes(data, work, N, channels, 1, 0);
+    } else {
+        dsps_fft4s_passes(data, work, N, 1, channels, N * 2);
+    }
+    return ESP_OK;
+}
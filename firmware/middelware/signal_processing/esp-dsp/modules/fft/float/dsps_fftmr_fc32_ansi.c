@@ -0,0 +1,338 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The mixed radix decomposition (fftmr_work, fftmr_factorize) and the radix 2, 3, 4 and 5
+// butterflies are derived from KISS FFT (https://github.com/mborgerding/kissfft),
+// distributed under the following license:
+//
+// Copyright (c) 2003-2010, Mark Borgerding
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the author nor the names of any contributors may be used to endorse
+//       or promote products derived from this software without specific prior
+//       written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dsps_fftmr.h"
+#include "dsp_types.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+static inline fc32_t fftmr_cmul(fc32_t a, fc32_t b)
+{
+    fc32_t r;
+    r.re = a.re * b.re - a.im * b.im;
+    r.im = a.re * b.im + a.im * b.re;
+    return r;
+}
+
+static void fftmr_bfly2(fc32_t *out, int fstride, const fc32_t *w, int m)
+{
+    fc32_t *out2 = out + m;
+    for (int k = 0; k < m; k++) {
+        fc32_t t = fftmr_cmul(out2[k], w[k * fstride]);
+        out2[k].re = out[k].re - t.re;
+        out2[k].im = out[k].im - t.im;
+        out[k].re += t.re;
+        out[k].im += t.im;
+    }
+}
+
+static void fftmr_bfly3(fc32_t *out, int fstride, const fc32_t *w, int m)
+{
+    // Im(exp(-2*pi*i/3))
+    const float epi3 = w[fstride * m].im;
+    for (int k = 0; k < m; k++) {
+        fc32_t s1 = fftmr_cmul(out[k + m], w[k * fstride]);
+        fc32_t s2 = fftmr_cmul(out[k + 2 * m], w[k * fstride * 2]);
+        fc32_t s3 = {.re = s1.re + s2.re, .im = s1.im + s2.im};
+        fc32_t s0 = {.re = (s1.re - s2.re) * epi3, .im = (s1.im - s2.im) * epi3};
+        float hr = out[k].re - 0.5f * s3.re;
+        float hi = out[k].im - 0.5f * s3.im;
+        out[k].re += s3.re;
+        out[k].im += s3.im;
+        out[k + 2 * m].re = hr + s0.im;
+        out[k + 2 * m].im = hi - s0.re;
+        out[k + m].re = hr - s0.im;
+        out[k + m].im = hi + s0.re;
+    }
+}
+
+static void fftmr_bfly4(fc32_t *out, int fstride, const fc32_t *w, int m)
+{
+    for (int k = 0; k < m; k++) {
+        fc32_t s0 = fftmr_cmul(out[k + m], w[k * fstride]);
+        fc32_t s1 = fftmr_cmul(out[k + 2 * m], w[k * fstride * 2]);
+        fc32_t s2 = fftmr_cmul(out[k + 3 * m], w[k * fstride * 3]);
+        fc32_t s5 = {.re = out[k].re - s1.re, .im = out[k].im - s1.im};
+        fc32_t f0 = {.re = out[k].re + s1.re, .im = out[k].im + s1.im};
+        fc32_t s3 = {.re = s0.re + s2.re, .im = s0.im + s2.im};
+        fc32_t s4 = {.re = s0.re - s2.re, .im = s0.im - s2.im};
+        out[k + 2 * m].re = f0.re - s3.re;
+        out[k + 2 * m].im = f0.im - s3.im;
+        out[k].re = f0.re + s3.re;
+        out[k].im = f0.im + s3.im;
+        out[k + m].re = s5.re + s4.im;
+        out[k + m].im = s5.im - s4.re;
+        out[k + 3 * m].re = s5.re - s4.im;
+        out[k + 3 * m].im = s5.im + s4.re;
+    }
+}
+
+static void fftmr_bfly5(fc32_t *out, int fstride, const fc32_t *w, int m)
+{
+    // exp(-2*pi*i/5) and exp(-4*pi*i/5)
+    const fc32_t ya = w[fstride * m];
+    const fc32_t yb = w[fstride * 2 * m];
+    fc32_t *f0 = out;
+    fc32_t *f1 = out + m;
+    fc32_t *f2 = out + 2 * m;
+    fc32_t *f3 = out + 3 * m;
+    fc32_t *f4 = out + 4 * m;
+    for (int u = 0; u < m; u++) {
+        fc32_t s0 = f0[u];
+        fc32_t s1 = fftmr_cmul(f1[u], w[u * fstride]);
+        fc32_t s2 = fftmr_cmul(f2[u], w[2 * u * fstride]);
+        fc32_t s3 = fftmr_cmul(f3[u], w[3 * u * fstride]);
+        fc32_t s4 = fftmr_cmul(f4[u], w[4 * u * fstride]);
+
+        fc32_t s7 = {.re = s1.re + s4.re, .im = s1.im + s4.im};
+        fc32_t s10 = {.re = s1.re - s4.re, .im = s1.im - s4.im};
+        fc32_t s8 = {.re = s2.re + s3.re, .im = s2.im + s3.im};
+        fc32_t s9 = {.re = s2.re - s3.re, .im = s2.im - s3.im};
+
+        f0[u].re = s0.re + s7.re + s8.re;
+        f0[u].im = s0.im + s7.im + s8.im;
+
+        fc32_t s5 = {.re = s0.re + s7.re * ya.re + s8.re * yb.re, .im = s0.im + s7.im * ya.re + s8.im * yb.re};
+        fc32_t s6 = {.re = s10.im * ya.im + s9.im * yb.im, .im = -s10.re * ya.im - s9.re * yb.im};
+        f1[u].re = s5.re - s6.re;
+        f1[u].im = s5.im - s6.im;
+        f4[u].re = s5.re + s6.re;
+        f4[u].im = s5.im + s6.im;
+
+        fc32_t s11 = {.re = s0.re + s7.re * yb.re + s8.re * ya.re, .im = s0.im + s7.im * yb.re + s8.im * ya.re};
+        fc32_t s12 = {.re = -s10.im * yb.im + s9.im * ya.im, .im = s10.re * yb.im - s9.re * ya.im};
+        f2[u].re = s11.re + s12.re;
+        f2[u].im = s11.im + s12.im;
+        f3[u].re = s11.re - s12.re;
+        f3[u].im = s11.im - s12.im;
+    }
+}
+
+// Decimation in time: out[0..p*m-1] = FFT of in[0], in[fstride], in[2*fstride]...
+static void fftmr_work(const fc32_t *w, fc32_t *out, const fc32_t *in, int fstride, const int *factors)
+{
+    const int p = factors[0];
+    const int m = factors[1];
+    fc32_t *out_beg = out;
+    const fc32_t *out_end = out + p * m;
+
+    if (m == 1) {
+        do {
+            *out = *in;
+            in += fstride;
+        } while (++out != out_end);
+    } else {
+        do {
+            fftmr_work(w, out, in, fstride * p, factors + 2);
+            in += fstride;
+        } while ((out += m) != out_end);
+    }
+    switch (p) {
+    case 2:
+        fftmr_bfly2(out_beg, fstride, w, m);
+        break;
+    case 3:
+        fftmr_bfly3(out_beg, fstride, w, m);
+        break;
+    case 4:
+        fftmr_bfly4(out_beg, fstride, w, m);
+        break;
+    default:
+        fftmr_bfly5(out_beg, fstride, w, m);
+        break;
+    }
+}
+
+// Splits N to radix 4, 2, 3 and 5 stages. Returns false if other factors remain.
+static bool fftmr_factorize(int N, int *factors)
+{
+    int n = N;
+    int i = 0;
+    while (n > 1) {
+        int p;
+        if ((n % 4) == 0) {
+            p = 4;
+        } else if ((n % 2) == 0) {
+            p = 2;
+        } else if ((n % 3) == 0) {
+            p = 3;
+        } else if ((n % 5) == 0) {
+            p = 5;
+        } else {
+            return false;
+        }
+        if (i >= DSPS_FFTMR_MAX_FACTORS) {
+            return false;
+        }
+        n /= p;
+        factors[2 * i] = p;
+        factors[2 * i + 1] = n;
+        i++;
+    }
+    return true;
+}
+
+esp_err_t dsps_fftmr_init_fc32(fftmr_fc32_t *plan, int N)
+{
+    if (NULL == plan) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (N < 2) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    memset(plan, 0, sizeof(fftmr_fc32_t));
+    plan->N = N;
+
+    if (fftmr_factorize(N, plan->factors)) {
+        plan->w = (float *)malloc(N * 2 * sizeof(float));
+        plan->work = (float *)malloc(N * 2 * sizeof(float));
+        if ((NULL == plan->w) || (NULL == plan->work)) {
+            dsps_fftmr_deinit_fc32(plan);
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        for (int k = 0; k < N; k++) {
+            double angle = 2 * M_PI * k / N;
+            plan->w[2 * k + 0] = (float)cos(angle);
+            plan->w[2 * k + 1] = (float) - sin(angle);
+        }
+        return ESP_OK;
+    }
+
+    // Bluestein: X[k] = chirp[k] * sum(x[n] * chirp[n] * conj(chirp[k - n]))
+    int M = 1;
+    while (M < (2 * N - 1)) {
+        M <<= 1;
+    }
+    plan->M = M;
+    plan->chirp = (float *)malloc(N * 2 * sizeof(float));
+    plan->chirp_fft = (float *)calloc(M * 2, sizeof(float));
+    plan->conv = (float *)malloc(M * 2 * sizeof(float));
+    plan->conv_plan = (fftmr_fc32_t *)malloc(sizeof(fftmr_fc32_t));
+    if ((NULL == plan->chirp) || (NULL == plan->chirp_fft) || (NULL == plan->conv) || (NULL == plan->conv_plan)) {
+        free(plan->conv_plan);
+        plan->conv_plan = NULL;
+        dsps_fftmr_deinit_fc32(plan);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    esp_err_t ret = dsps_fftmr_init_fc32(plan->conv_plan, M);
+    if (ret != ESP_OK) {
+        free(plan->conv_plan);
+        plan->conv_plan = NULL;
+        dsps_fftmr_deinit_fc32(plan);
+        return ret;
+    }
+    for (int n = 0; n < N; n++) {
+        // n^2 mod 2N keeps the angle exact for long transforms
+        long long n2 = ((long long)n * n) % (2 * N);
+        double angle = M_PI * n2 / N;
+        plan->chirp[2 * n + 0] = (float)cos(angle);
+        plan->chirp[2 * n + 1] = (float) - sin(angle);
+        // conj(chirp) at n and -n, scaled by 1/M for the inverse transform
+        float re = (float)(cos(angle) / M);
+        float im = (float)(sin(angle) / M);
+        plan->chirp_fft[2 * n + 0] = re;
+        plan->chirp_fft[2 * n + 1] = im;
+        if (n > 0) {
+            plan->chirp_fft[2 * (M - n) + 0] = re;
+            plan->chirp_fft[2 * (M - n) + 1] = im;
+        }
+    }
+    dsps_fftmr_fc32_ansi(plan->conv_plan, plan->chirp_fft);
+    return ESP_OK;
+}
+
+esp_err_t dsps_fftmr_deinit_fc32(fftmr_fc32_t *plan)
+{
+    if (NULL == plan) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (plan->conv_plan != NULL) {
+        dsps_fftmr_deinit_fc32(plan->conv_plan);
+        free(plan->conv_plan);
+    }
+    free(plan->w);
+    free(plan->work);
+    free(plan->chirp);
+    free(plan->chirp_fft);
+    free(plan->conv);
+    memset(plan, 0, sizeof(fftmr_fc32_t));
+    return ESP_OK;
+}
+
+esp_err_t dsps_fftmr_fc32_ansi(const fftmr_fc32_t *plan, float *data)
+{
+    if ((NULL == plan) || (plan->N == 0)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (NULL == data) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    const int N = plan->N;
+    if (plan->M == 0) {
+        fftmr_work((const fc32_t *)plan->w, (fc32_t *)plan->work, (const fc32_t *)data, 1, plan->factors);
+        memcpy(data, plan->work, N * 2 * sizeof(float));
+        return ESP_OK;
+    }
+
+    const int M = plan->M;
+    fc32_t *x = (fc32_t *)data;
+    fc32_t *c = (fc32_t *)plan->conv;
+    const fc32_t *chirp = (const fc32_t *)plan->chirp;
+    const fc32_t *b = (const fc32_t *)plan->chirp_fft;
+    for (int n = 0; n < N; n++) {
+        c[n] = fftmr_cmul(x[n], chirp[n]);
+    }
+    memset(&c[N], 0, (M - N) * sizeof(fc32_t));
+    dsps_fftmr_fc32_ansi(plan->conv_plan, plan->conv);
+    // Inverse FFT as conj(FFT(conj(C * B)))
+    for (int k = 0; k < M; k++) {
+        c[k] = fftmr_cmul(c[k], b[k]);
+        c[k].im = -c[k].im;
+    }
+    dsps_fftmr_fc32_ansi(plan->conv_plan, plan->conv);
+    for (int k = 0; k < N; k++) {
+        fc32_t v = {.re = c[k].re, .im = -c[k].im};
+        x[k] = fftmr_cmul(v, chirp[k]);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generate float/dsps_fft_w_tables_fc32.c (static FFT twiddle tables).
+
+Usage: gen_fft_w_tables.py [max_size] > float/dsps_fft_w_tables_fc32.c
+"""
+
+import math
+import struct
+import sys
+
+MIN_SIZE = 16
+PER_LINE = 6
+
+LICENSE = '''\
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+'''
+
+
+def f32(v):
+    v = struct.unpack('f', struct.pack('f', v))[0]
+    if v == 0.0:
+        v = 0.0  # no negative zeros
+    return '%.9ef' % v
+
+
+def bitrev(x, bits):
+    r = 0
+    for _ in range(bits):
+        r = (r << 1) | (x & 1)
+        x >>= 1
+    return r
+
+
+def emit(values, out):
+    for i in range(0, len(values), PER_LINE):
+        out.append('    ' + ', '.join(f32(v) for v in values[i:i + PER_LINE]) + ',')
+
+
+def main():
+    max_size = int(sys.argv[1]) if len(sys.argv) > 1 else 4096
+    out = []
+    out.append(LICENSE)
+    out.append('// Generated by gen_fft_w_tables.py, do not edit.')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('#include "sdkconfig.h"')
+    out.append('#include "dsps_fft_tables.h"')
+    out.append('')
+    out.append('#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE')
+    out.append('')
+    # Radix-2 table: exp(2*pi*i*k/N) for k < N/2 in bit reversed order.
+    # The table of size N starts with the table of size N/2, so one array
+    # with nested size blocks serves all sizes.
+    bits = int(math.log2(max_size // 2))
+    w = []
+    for j in range(max_size // 2):
+        k = bitrev(j, bits)
+        a = 2 * math.pi * k / max_size
+        w += [math.cos(a), math.sin(a)]
+    out.append('const float dsps_fft2r_w_table_static_fc32[CONFIG_DSP_FFT_STATIC_TABLE_SIZE] = {')
+    emit(w[:MIN_SIZE], out)
+    n = MIN_SIZE
+    while n < max_size:
+        out.append('#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE > %d' % n)
+        emit(w[n:2 * n], out)
+        n *= 2
+    for n in range(int(math.log2(max_size // MIN_SIZE))):
+        out.append('#endif')
+    out.append('};')
+    out.append('')
+    # Radix-4 auto-sort table: exp(-2*pi*i*k/N) for k < 3*N/4 in natural order
+    n = MIN_SIZE
+    cond = '#if'
+    while n <= max_size:
+        out.append('%s CONFIG_DSP_FFT_STATIC_TABLE_SIZE == %d' % (cond, n))
+        out.append('const float dsps_fft4s_w_table_static_fc32[%d] = {' % (n * 3 // 2))
+        w = []
+        for k in range(n * 3 // 4):
+            a = 2 * math.pi * k / n
+            w += [math.cos(a), -math.sin(a)]
+        emit(w, out)
+        out.append('};')
+        cond = '#elif'
+        n *= 2
+    out.append('#else')
+    out.append('#error "CONFIG_DSP_FFT_STATIC_TABLE_SIZE must be a power of two from %d to %d"'
+               % (MIN_SIZE, max_size))
+    out.append('#endif')
+    out.append('')
+    out.append('#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE')
+    print('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
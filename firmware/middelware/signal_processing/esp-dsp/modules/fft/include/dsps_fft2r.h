@@ -107,6 +107,31 @@ esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
 #define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_sc16_ansi(data, N) dsps_fft2r_sc16_ansi_(data, N, dsps_fft_w_table_sc16)
 
+/**@{*/
+/**
+ * @brief      complex FFT of radix 2 with block floating point scaling
+ *
+ * Same transform as dsps_fft2r_sc16, but instead of a fixed shift by 1 on every stage
+ * the block maximum is checked before each stage and data is shifted only when the
+ * stage could overflow. Input block is normalized first, so low amplitude signals keep
+ * their resolution. The result is: FFT(x)[k] = data[k] * 2^exponent.
+ * The fixed scaling of dsps_fft2r_sc16 corresponds to exponent = log2(N).
+ * The implementation use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *               result of FFT will be stored to this array.
+ * @param[in] N: Number of complex elements in input array
+ * @param[in] w: pointer to the sin/cos table
+ * @param[out] exponent: block exponent of the result
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_sc16_bfp_ansi_(int16_t *data, int N, int16_t *w, int *exponent);
+/**@}*/
+#define dsps_fft2r_sc16_bfp_ansi(data, N, exponent) dsps_fft2r_sc16_bfp_ansi_(data, N, dsps_fft_w_table_sc16, exponent)
+
 
 /**@{*/
 /**
@@ -242,4 +267,6 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 
 #endif // CONFIG_DSP_OPTIMIZED
 
+#define dsps_fft2r_sc16_bfp dsps_fft2r_sc16_bfp_ansi
+
 #endif // _dsps_fft2r_H_
@@ -0,0 +1,127 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fft4s_H_
+#define _dsps_fft4s_H_
+#include "dsp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data layout of the multi-channel FFT
+ */
+typedef enum {
+    DSPS_FFT_CHANNEL_MAJOR = 0, /*!< Channel c, element n located at data[(c*N + n)*2]*/
+    DSPS_FFT_INTERLEAVED = 1,   /*!< Channel c, element n located at data[(n*channels + c)*2]*/
+} dsps_fft_layout_t;
+
+extern float *dsps_fft4s_w_table_fc32;
+extern int dsps_fft4s_w_table_size;
+extern float *dsps_fft4s_work_fc32;
+extern int dsps_fft4s_max_size;
+extern uint8_t dsps_fft4s_initialized;
+
+/**@{*/
+/**
+ * @brief      init fft tables
+ *
+ * Initialization of Complex FFT Radix-4 with auto-sort (Stockham) data flow.
+ * This function initialize coefficients table and the ping-pong working buffer.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] fft_buff: pointer to floating point buffer of max_fft_size*4 elements, where
+ *                         sin/cos table and working buffer will be stored.
+ *                         When static tables are built (CONFIG_DSP_FFT_STATIC_TABLE_SIZE >= max_fft_size)
+ *                         only the working buffer of max_fft_size*2 elements is required.
+ *                         If this parameter set to NULL the buffer will be allocated internally.
+ * @param[in] max_fft_size: maximum fft size, power of two.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if max_fft_size > CONFIG_DSP_MAX_FFT_SIZE or no memory
+ *      - ESP_ERR_DSP_INVALID_LENGTH if max_fft_size is not power of two
+ *      - ESP_ERR_DSP_REINITIALIZED if already initialized with a smaller max_fft_size or fft_buff
+ *        is not NULL, call dsps_fft4s_deinit_fc32 first. A new call with NULL and a size
+ *        up to the initialized one returns ESP_OK.
+ */
+esp_err_t dsps_fft4s_init_fc32(float *fft_buff, int max_fft_size);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      deinit fft tables
+ *
+ * Free resources of Complex FFT Radix-4 auto-sort, if they were allocated by dsps_fft4s_init_fc32.
+ */
+void dsps_fft4s_deinit_fc32(void);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      complex FFT of radix 4 with natural order output
+ *
+ * Forward complex FFT. The radix-4 passes use Stockham auto-sort indexing,
+ * so the result is in natural order and no bit reverse pass is required.
+ * Sizes with odd power of two end with one radix-2 pass.
+ * The last pass is done in place into the data array, the other passes
+ * use the internal working buffer.
+ * The implementation use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *               result of FFT will be stored to this array.
+ * @param[in] N: Number of complex elements in input array, power of two up to max_fft_size
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if dsps_fft4s_init_fc32 was not called
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N is not supported
+ */
+esp_err_t dsps_fft4s_fc32_ansi(float *data, int N);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      multi-channel complex FFT of radix 4 with natural order output
+ *
+ * Forward complex FFT of several channels with the same length in one call.
+ * Every twiddle factor is loaded once and applied to all channels.
+ * The result has the same layout as the input.
+ * The implementation use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[inout] data: input/output complex array of N*channels elements
+ * @param[in] N: Number of complex elements of each channel, power of two up to max_fft_size
+ * @param[in] channels: number of channels
+ * @param[in] layout: channel-major or interleaved data
+ * @param[in] work: working buffer of N*channels complex elements. If NULL the internal
+ *                  working buffer is used, then N*channels must not exceed max_fft_size.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if dsps_fft4s_init_fc32 was not called
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N or channels is not supported
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if data is NULL
+ */
+esp_err_t dsps_fft4s_batch_fc32_ansi(float *data, int N, int channels, dsps_fft_layout_t layout, float *work);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#define dsps_fft4s_fc32 dsps_fft4s_fc32_ansi
+#define dsps_fft4s_batch_fc32 dsps_fft4s_batch_fc32_ansi
+
+#endif // _dsps_fft4s_H_
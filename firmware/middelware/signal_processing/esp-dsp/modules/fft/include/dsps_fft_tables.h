@@ -82,6 +82,12 @@ void dsps_fft4r_rev_tables_init_fc32(void);
 extern uint16_t *dsps_fft4r_rev_tables_fc32[];
 extern const uint16_t dsps_fft4r_rev_tables_fc32_size[];
 
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+// Twiddle tables generated at build time (float/dsps_fft_w_tables_fc32.c)
+extern const float dsps_fft2r_w_table_static_fc32[];
+extern const float dsps_fft4s_w_table_static_fc32[];
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,106 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fftmr_H_
+#define _dsps_fftmr_H_
+#include "dsp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_FFTMR_MAX_FACTORS 32
+
+/**
+ * @brief Plan of the mixed radix complex FFT
+ *
+ * Lengths with factors 2, 3 and 5 only are calculated by mixed radix 4/2/3/5
+ * decimation in time. All other lengths use the Bluestein (chirp-z) algorithm
+ * with a power of two convolution of at least 2*N-1 points.
+ * The plan is calculated once by dsps_fftmr_init_fc32() and could be reused
+ * for any number of transforms of the same length.
+ * Heap used by a plan: 16*N bytes for mixed radix, 8*N + 32*M bytes for Bluestein
+ * (e.g. N = 2047, M = 4096: 144 KB).
+ */
+typedef struct fftmr_fc32_s {
+    int N;                                      /*!< FFT length*/
+    int factors[2 * DSPS_FFTMR_MAX_FACTORS];    /*!< (radix, remaining length) pairs*/
+    float *w;                                   /*!< exp(-2*pi*i*k/N), k = 0..N-1*/
+    float *work;                                /*!< N complex values working buffer*/
+    int M;                                      /*!< Bluestein convolution length, 0 if not used*/
+    float *chirp;                               /*!< exp(-pi*i*n^2/N), n = 0..N-1*/
+    float *chirp_fft;                           /*!< FFT of the conjugated chirp, scaled by 1/M*/
+    float *conv;                                /*!< M complex values convolution buffer*/
+    struct fftmr_fc32_s *conv_plan;             /*!< M points plan used by Bluestein*/
+} fftmr_fc32_t;
+
+/**@{*/
+/**
+ * @brief      init mixed radix FFT plan
+ *
+ * Calculates factors, twiddle factors and allocates working buffers for one FFT length.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[out] plan: pointer to the plan structure
+ * @param[in] N: FFT length, any value from 2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N < 2
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if plan is NULL or not enough memory
+ */
+esp_err_t dsps_fftmr_init_fc32(fftmr_fc32_t *plan, int N);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      deinit mixed radix FFT plan
+ *
+ * Free all buffers allocated by dsps_fftmr_init_fc32.
+ *
+ * @param[inout] plan: pointer to the plan structure
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if plan is NULL
+ */
+esp_err_t dsps_fftmr_deinit_fc32(fftmr_fc32_t *plan);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      complex FFT of any length
+ *
+ * Forward complex FFT, result in natural order.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] plan: plan initialized by dsps_fftmr_init_fc32
+ * @param[inout] data: input/output complex array of plan->N elements. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *               result of FFT will be stored to this array.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if plan is not initialized
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if data is NULL
+ */
+esp_err_t dsps_fftmr_fc32_ansi(const fftmr_fc32_t *plan, float *data);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#define dsps_fftmr_fc32 dsps_fftmr_fc32_ansi
+
+#endif // _dsps_fftmr_H_
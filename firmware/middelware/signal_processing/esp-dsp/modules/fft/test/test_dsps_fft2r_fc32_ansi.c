@@ -117,3 +117,45 @@ TEST_CASE("dsps_gen_bitrev2r_table bitrev table generation.", "[dsps]")
         dsps_gen_bitrev2r_table(N_check, 8, "fc32");
     }
 }
+
+#if CONFIG_DSP_FFT_STATIC_TABLE_SIZE
+TEST_CASE("dsps_fft2r_fc32_ansi static tables", "[dsps]")
+{
+    const int N = CONFIG_DSP_FFT_STATIC_TABLE_SIZE;
+    float *w = (float *)malloc(N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(w);
+    float *data = (float *)malloc(2 * N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+
+    // Static table must be equal to the table calculated by dsps_fft2r_init_fc32
+    TEST_ESP_OK(dsps_gen_w_r2_fc32(w, N));
+    TEST_ESP_OK(dsps_bit_rev_fc32_ansi(w, N >> 1));
+    for (int i = 0; i < N; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, w[i], dsps_fft2r_w_table_static_fc32[i]);
+    }
+    // FFT is available without dsps_fft2r_init_fc32 call
+    for (int i = 0; i < N; i++) {
+        data[i * 2] = cosf(2 * M_PI * 8 * i / N);
+        data[i * 2 + 1] = 0;
+    }
+    TEST_ESP_OK(dsps_fft2r_fc32_ansi(data, N));
+    TEST_ESP_OK(dsps_bit_rev_fc32_ansi(data, N));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3 * N, N / 2, data[8 * 2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3 * N, 0, data[9 * 2]);
+
+    // Bigger table is initialized at runtime and static table is restored by deinit
+    if (N < CONFIG_DSP_MAX_FFT_SIZE) {
+        TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N * 2));
+        TEST_ASSERT_TRUE(dsps_fft_w_table_fc32 != dsps_fft2r_w_table_static_fc32);
+        dsps_fft2r_deinit_fc32();
+    }
+    TEST_ASSERT_TRUE(dsps_fft_w_table_fc32 == dsps_fft2r_w_table_static_fc32);
+    TEST_ESP_OK(dsps_fft2r_fc32_ansi(data, N));
+    // Size limit is still checked with the static table
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE * 2));
+    TEST_ASSERT_TRUE(dsps_fft_w_table_fc32 == dsps_fft2r_w_table_static_fc32);
+
+    free(w);
+    free(data);
+}
+#endif // CONFIG_DSP_FFT_STATIC_TABLE_SIZE
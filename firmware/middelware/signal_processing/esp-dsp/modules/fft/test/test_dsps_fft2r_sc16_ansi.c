@@ -116,3 +116,72 @@ TEST_CASE("dsps_fft2r_sc16_ansi benchmark", "[dsps]")
     }
     dsps_fft2r_deinit_sc16();
 }
+
+// SNR of the fixed point FFT result against a double precision DFT
+static float fft_sc16_snr(const int16_t *result, int exponent, const int16_t *input, int N)
+{
+    double sig = 0;
+    double err = 0;
+    for (int k = 0 ; k < N ; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0 ; n < N ; n++) {
+            double phase = -2 * M_PI * (double)((k * n) % N) / N;
+            re += input[n * 2 + 0] * cos(phase) - input[n * 2 + 1] * sin(phase);
+            im += input[n * 2 + 0] * sin(phase) + input[n * 2 + 1] * cos(phase);
+        }
+        double scale = ldexp(1.0, exponent);
+        double d_re = result[k * 2 + 0] * scale - re;
+        double d_im = result[k * 2 + 1] * scale - im;
+        sig += re * re + im * im;
+        err += d_re * d_re + d_im * d_im;
+    }
+    return 10 * log10(sig / (err + 1e-30));
+}
+
+TEST_CASE("dsps_fft2r_sc16_bfp_ansi functionality", "[dsps]")
+{
+    int N = 256;
+    int16_t *input = (int16_t *)malloc(N * 2 * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(input);
+    esp_err_t ret = dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    TEST_ESP_OK(ret);
+
+    // Low amplitude and full scale input
+    const float amplitudes[] = {0.003, 0.5, 1.0};
+    for (int a = 0 ; a < sizeof(amplitudes) / sizeof(amplitudes[0]) ; a++) {
+        for (int i = 0 ; i < N ; i++) {
+            input[i * 2 + 0] = (INT16_MAX) * amplitudes[a] * sin(M_PI / N * 2 * 17.3 * i);
+            input[i * 2 + 1] = (INT16_MAX) * amplitudes[a] * 0.5 * cos(M_PI / N * 2 * 5 * i);
+        }
+
+        memcpy(data, input, N * 2 * sizeof(int16_t));
+        dsps_fft2r_sc16_ansi(data, N);
+        dsps_bit_rev_sc16_ansi(data, N);
+        float snr_fixed = fft_sc16_snr(data, dsp_power_of_two(N), input, N);
+
+        int exponent = 0;
+        memcpy(data, input, N * 2 * sizeof(int16_t));
+        unsigned int start_b = xthal_get_ccount();
+        ret = dsps_fft2r_sc16_bfp_ansi(data, N, &exponent);
+        unsigned int end_b = xthal_get_ccount();
+        TEST_ESP_OK(ret);
+        dsps_bit_rev_sc16_ansi(data, N);
+        float snr_bfp = fft_sc16_snr(data, exponent, input, N);
+
+        ESP_LOGI(TAG, "amplitude %f: exponent %i, SNR fixed %2.1f dB, SNR bfp %2.1f dB, %i cycles",
+                 amplitudes[a], exponent, snr_fixed, snr_bfp, end_b - start_b);
+        TEST_ASSERT_MESSAGE(snr_bfp > 60, "Result out of range!");
+        TEST_ASSERT_MESSAGE(snr_bfp >= snr_fixed - 1, "Result out of range!");
+    }
+
+    // Zero input is a valid block
+    int exponent = 1;
+    memset(data, 0, N * 2 * sizeof(int16_t));
+    TEST_ESP_OK(dsps_fft2r_sc16_bfp_ansi(data, N, &exponent));
+    TEST_ASSERT_EQUAL(0, exponent);
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fft2r_sc16_bfp_ansi(data, N, NULL));
+
+    free(input);
+    dsps_fft2r_deinit_sc16();
+}
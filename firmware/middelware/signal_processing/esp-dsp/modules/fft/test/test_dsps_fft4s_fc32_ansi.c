@@ -0,0 +1,201 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft2r.h"
+#include "dsps_fft4r.h"
+#include "dsps_fft4s.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft4s_ansi";
+
+TEST_CASE("dsps_fft4s_fc32_ansi functionality", "[dsps]")
+{
+    const int max_N = 4096;
+    float *data = (float *)memalign(16, sizeof(float) * max_N * 2);
+    TEST_ASSERT_NOT_NULL(data);
+    float *check_data_fft = (float *)memalign(16, sizeof(float) * max_N * 2);
+    TEST_ASSERT_NOT_NULL(check_data_fft);
+
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, max_N));
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, max_N));
+
+    for (int N = 2; N <= max_N; N <<= 1) {
+        for (int i = 0; i < N; i++) {
+            data[i * 2] = cosf(2 * M_PI * 4 / 256 * i) + 0.1f * (i % 5);
+            data[i * 2 + 1] = sinf(2 * M_PI * 18 / 256 * i);
+            check_data_fft[i * 2] = data[i * 2];
+            check_data_fft[i * 2 + 1] = data[i * 2 + 1];
+        }
+        dsps_fft2r_fc32_ansi(data, N);
+        dsps_bit_rev_fc32_ansi(data, N);
+
+        TEST_ESP_OK(dsps_fft4s_fc32_ansi(check_data_fft, N));
+
+        float diff = 0;
+        for (int i = 0; i < N * 2; i++) {
+            diff += fabs(data[i] - check_data_fft[i]);
+        }
+        diff = diff / N;
+        ESP_LOGI(TAG, "diff[%i] = %f", N, diff);
+        if (diff > 0.0001) {
+            TEST_ASSERT_MESSAGE (false, "Result out of range!\n");
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft4s_fc32_ansi(data, 48));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft4s_fc32_ansi(data, max_N * 2));
+    // Re-init: smaller size reuses the tables, bigger size requires deinit first
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, max_N / 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_REINITIALIZED, dsps_fft4s_init_fc32(NULL, max_N * 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_REINITIALIZED, dsps_fft4s_init_fc32(data, max_N / 2));
+
+    dsps_fft2r_deinit_fc32();
+    dsps_fft4s_deinit_fc32();
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft4s_fc32_ansi(data, 64));
+    free(data);
+    free(check_data_fft);
+}
+
+TEST_CASE("dsps_fft4s_fc32_ansi benchmark", "[dsps]")
+{
+    const int max_N = 4096;
+    float *data = (float *)memalign(16, sizeof(float) * max_N * 2);
+    TEST_ASSERT_NOT_NULL(data);
+
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, max_N));
+    TEST_ESP_OK(dsps_fft4r_init_fc32(NULL, max_N));
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, max_N));
+
+    for (int N = 64; N <= max_N; N <<= 1) {
+        for (int i = 0; i < N * 2; i++) {
+            data[i] = (float)(i % 17) - 8;
+        }
+        unsigned int start_b = xthal_get_ccount();
+        dsps_fft2r_fc32_ansi(data, N);
+        dsps_bit_rev_fc32_ansi(data, N);
+        unsigned int end_b = xthal_get_ccount();
+        unsigned int cycles_2r = end_b - start_b;
+
+        unsigned int cycles_4r = 0;
+        if ((dsp_power_of_two(N) & 1) == 0) {
+            start_b = xthal_get_ccount();
+            dsps_fft4r_fc32_ansi(data, N);
+            dsps_bit_rev4r_fc32(data, N);
+            end_b = xthal_get_ccount();
+            cycles_4r = end_b - start_b;
+        }
+
+        start_b = xthal_get_ccount();
+        dsps_fft4s_fc32_ansi(data, N);
+        end_b = xthal_get_ccount();
+        unsigned int cycles_4s = end_b - start_b;
+
+        ESP_LOGI(TAG, "Benchmark N = %4i: fft2r+bitrev %8i, fft4r+bitrev %8i, fft4s %8i cycles",
+                 N, cycles_2r, cycles_4r, cycles_4s);
+    }
+    dsps_fft2r_deinit_fc32();
+    dsps_fft4r_deinit_fc32();
+    dsps_fft4s_deinit_fc32();
+    free(data);
+}
+
+TEST_CASE("dsps_fft4s_batch_fc32_ansi functionality", "[dsps]")
+{
+    const int max_N = 512;
+    const int channels = 5;
+    float *data = (float *)memalign(16, sizeof(float) * max_N * channels * 2);
+    float *check = (float *)memalign(16, sizeof(float) * max_N * channels * 2);
+    float *work = (float *)memalign(16, sizeof(float) * max_N * channels * 2);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(check);
+    TEST_ASSERT_NOT_NULL(work);
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, max_N));
+
+    for (int N = 2; N <= max_N; N <<= 1) {
+        for (int layout = DSPS_FFT_CHANNEL_MAJOR; layout <= DSPS_FFT_INTERLEAVED; layout++) {
+            // Reference: channel-major data transformed one by one
+            for (int c = 0; c < channels; c++) {
+                for (int i = 0; i < N; i++) {
+                    float re = cosf(2 * M_PI * (c + 1) * i / N) + 0.05f * ((i * (c + 3)) % 11);
+                    float im = 0.1f * c;
+                    check[(c * N + i) * 2] = re;
+                    check[(c * N + i) * 2 + 1] = im;
+                    int pos = (layout == DSPS_FFT_INTERLEAVED) ? (i * channels + c) : (c * N + i);
+                    data[pos * 2] = re;
+                    data[pos * 2 + 1] = im;
+                }
+                TEST_ESP_OK(dsps_fft4s_fc32_ansi(&check[c * N * 2], N));
+            }
+            TEST_ESP_OK(dsps_fft4s_batch_fc32_ansi(data, N, channels, layout, work));
+            for (int c = 0; c < channels; c++) {
+                for (int i = 0; i < N; i++) {
+                    int pos = (layout == DSPS_FFT_INTERLEAVED) ? (i * channels + c) : (c * N + i);
+                    TEST_ASSERT_FLOAT_WITHIN(1e-4 * N, check[(c * N + i) * 2], data[pos * 2]);
+                    TEST_ASSERT_FLOAT_WITHIN(1e-4 * N, check[(c * N + i) * 2 + 1], data[pos * 2 + 1]);
+                }
+            }
+        }
+    }
+    // Internal working buffer is too small for 5 channels of max_N points
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft4s_batch_fc32_ansi(data, max_N, channels, DSPS_FFT_CHANNEL_MAJOR, NULL));
+    TEST_ESP_OK(dsps_fft4s_batch_fc32_ansi(data, max_N / 8, channels, DSPS_FFT_CHANNEL_MAJOR, NULL));
+
+    dsps_fft4s_deinit_fc32();
+    free(data);
+    free(check);
+    free(work);
+}
+
+TEST_CASE("dsps_fft4s_batch_fc32_ansi benchmark", "[dsps]")
+{
+    const int N = 256;
+    const int max_channels = 8;
+    float *data = (float *)memalign(16, sizeof(float) * N * max_channels * 2);
+    float *work = (float *)memalign(16, sizeof(float) * N * max_channels * 2);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(work);
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, N));
+    for (int i = 0; i < N * max_channels * 2; i++) {
+        data[i] = (float)(i % 17) - 8;
+    }
+
+    for (int channels = 4; channels <= max_channels; channels += 4) {
+        unsigned int start_b = xthal_get_ccount();
+        for (int c = 0; c < channels; c++) {
+            dsps_fft4s_fc32_ansi(&data[c * N * 2], N);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        unsigned int cycles_single = end_b - start_b;
+
+        start_b = xthal_get_ccount();
+        dsps_fft4s_batch_fc32_ansi(data, N, channels, DSPS_FFT_CHANNEL_MAJOR, work);
+        end_b = xthal_get_ccount();
+        unsigned int cycles_major = end_b - start_b;
+
+        start_b = xthal_get_ccount();
+        dsps_fft4s_batch_fc32_ansi(data, N, channels, DSPS_FFT_INTERLEAVED, work);
+        end_b = xthal_get_ccount();
+        unsigned int cycles_interleaved = end_b - start_b;
+
+        ESP_LOGI(TAG, "Benchmark %i x %i points: single calls %8i, channel-major %8i, interleaved %8i cycles",
+                 channels, N, cycles_single, cycles_major, cycles_interleaved);
+    }
+    dsps_fft4s_deinit_fc32();
+    free(data);
+    free(work);
+}
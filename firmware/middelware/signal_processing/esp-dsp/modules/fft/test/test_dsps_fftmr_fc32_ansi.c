@@ -0,0 +1,104 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fftmr.h"
+#include "dsps_fft4s.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fftmr_ansi";
+
+// 2..5 factors only, then lengths calculated by Bluestein algorithm
+static const int test_lengths[] = {2, 3, 5, 6, 12, 15, 60, 64, 100, 375, 750, 1000, 7, 17, 98, 127, 511, 997};
+
+TEST_CASE("dsps_fftmr_fc32_ansi functionality", "[dsps]")
+{
+    const int max_N = 1000;
+    float *data = (float *)memalign(16, sizeof(float) * max_N * 2);
+    float *input = (float *)memalign(16, sizeof(float) * max_N * 2);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(input);
+
+    for (int t = 0; t < sizeof(test_lengths) / sizeof(int); t++) {
+        int N = test_lengths[t];
+        fftmr_fc32_t plan;
+        TEST_ESP_OK(dsps_fftmr_init_fc32(&plan, N));
+        for (int i = 0; i < N; i++) {
+            input[i * 2] = cosf(2 * M_PI * 3.3f * i / N) + 0.1f * (i % 7);
+            input[i * 2 + 1] = sinf(2 * M_PI * 1.7f * i / N);
+            data[i * 2] = input[i * 2];
+            data[i * 2 + 1] = input[i * 2 + 1];
+        }
+        TEST_ESP_OK(dsps_fftmr_fc32_ansi(&plan, data));
+
+        // Reference DFT in double precision
+        double max_err = 0;
+        for (int k = 0; k < N; k++) {
+            double re = 0;
+            double im = 0;
+            for (int n = 0; n < N; n++) {
+                double a = -2 * M_PI * (double)(((long long)k * n) % N) / N;
+                re += input[n * 2] * cos(a) - input[n * 2 + 1] * sin(a);
+                im += input[n * 2] * sin(a) + input[n * 2 + 1] * cos(a);
+            }
+            double err = fabs(re - data[k * 2]) + fabs(im - data[k * 2 + 1]);
+            if (err > max_err) {
+                max_err = err;
+            }
+        }
+        // Error relative to N, the input values are about 1
+        max_err /= N;
+        ESP_LOGI(TAG, "N = %4i, %s, max error = %e", N, plan.M ? "Bluestein" : "mixed radix", max_err);
+        TEST_ASSERT_MESSAGE(max_err < 3e-7, "Result out of range!");
+        TEST_ESP_OK(dsps_fftmr_deinit_fc32(&plan));
+    }
+    fftmr_fc32_t plan;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fftmr_init_fc32(&plan, 1));
+    free(data);
+    free(input);
+}
+
+TEST_CASE("dsps_fftmr_fc32_ansi benchmark", "[dsps]")
+{
+    const int lengths[] = {750, 1000, 997, 1024};
+    float *data = (float *)memalign(16, sizeof(float) * 1024 * 2);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ESP_OK(dsps_fft4s_init_fc32(NULL, 1024));
+
+    for (int t = 0; t < sizeof(lengths) / sizeof(int); t++) {
+        int N = lengths[t];
+        fftmr_fc32_t plan;
+        TEST_ESP_OK(dsps_fftmr_init_fc32(&plan, N));
+        for (int i = 0; i < N * 2; i++) {
+            data[i] = (float)(i % 13) - 6;
+        }
+        unsigned int start_b = xthal_get_ccount();
+        dsps_fftmr_fc32_ansi(&plan, data);
+        unsigned int end_b = xthal_get_ccount();
+        ESP_LOGI(TAG, "Benchmark dsps_fftmr_fc32_ansi - %8i cycles for %4i points FFT (%s).",
+                 end_b - start_b, N, plan.M ? "Bluestein" : "mixed radix");
+        TEST_ESP_OK(dsps_fftmr_deinit_fc32(&plan));
+    }
+    unsigned int start_b = xthal_get_ccount();
+    dsps_fft4s_fc32_ansi(data, 1024);
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Benchmark dsps_fft4s_fc32_ansi - %8i cycles for 1024 points FFT (zero padding).", end_b - start_b);
+
+    dsps_fft4s_deinit_fc32();
+    free(data);
+}
@@ -31,6 +31,9 @@ ekf::ekf(int x, int w) : NUMX(x),
     this->X.data[0] = 1; // direction to 0
     this->HP = new float[this->NUMX];
     this->Km = new float[this->NUMX];
+    this->Hnz = new int[this->NUMX];
+    this->Kx = new float[3 * this->NUMX];
+    this->integrator = RK4;
     for (size_t i = 0; i < this->NUMX; i++) {
         this->HP[i] = 0;
         this->Km[i] = 0;
@@ -45,36 +48,78 @@ ekf::~ekf()
     delete &P;
     delete &Q;
 
-    delete this->HP;
-    delete this->Km;
+    delete[] this->HP;
+    delete[] this->Km;
+    delete[] this->Hnz;
+    delete[] this->Kx;
 }
 
 void ekf::Process(float *u, float dt)
 {
     this->LinearizeFG(this->X, (float *)u);
-    this->RungeKutta(this->X, u, dt);
+    this->Integrate(this->X.data, u, dt, this->integrator);
     this->CovariancePrediction(dt);
 }
 
 void ekf::RungeKutta(dspm::Mat &x, float *U, float dt)
 {
+    this->Integrate(x.data, U, dt, RK4);
+}
 
-    float dt2 = dt / 2.0f;
-
-    dspm::Mat Xlast = x;          // make a working copy
-    dspm::Mat K1 = StateXdot(x, U); // k1 = f(x, u)
-    x = Xlast + (K1 * dt2);
-
-    dspm::Mat K2 = StateXdot(x, U); // k2 = f(x + 0.5*dT*k1, u)
-    x = Xlast + K2 * dt2;
-
-    dspm::Mat K3 = StateXdot(x, U); // k3 = f(x + 0.5*dT*k2, u)
-    x = Xlast + K3 * dt;
-
-    dspm::Mat K4 = StateXdot(x, U); // k4 = f(x + dT * k3, u)
+void ekf::Integrate(float *x, float *U, float dt, Integrator method)
+{
+    const int n = this->NUMX;
+    float *K = &this->Kx[0];        // current derivative
+    float *Ksum = &this->Kx[n];     // weighted sum of derivatives
+    float *Xtmp = &this->Kx[2 * n]; // intermediate state
+
+    switch (method) {
+    case Euler:
+        StateXdot(x, U, K); // k1 = f(x, u)
+        for (int i = 0; i < n; i++) {
+            x[i] += K[i] * dt;
+        }
+        break;
+    case RK2: {
+        float dt2 = dt / 2.0f;
+        StateXdot(x, U, K); // k1 = f(x, u)
+        for (int i = 0; i < n; i++) {
+            Xtmp[i] = x[i] + K[i] * dt2;
+        }
+        StateXdot(Xtmp, U, K); // k2 = f(x + 0.5*dT*k1, u)
+        for (int i = 0; i < n; i++) {
+            x[i] += K[i] * dt;
+        }
+        break;
+    }
+    case RK4:
+    default: {
+        float dt2 = dt / 2.0f;
+        StateXdot(x, U, K); // k1 = f(x, u)
+        for (int i = 0; i < n; i++) {
+            Ksum[i] = K[i];
+            Xtmp[i] = x[i] + K[i] * dt2;
+        }
+        StateXdot(Xtmp, U, K); // k2 = f(x + 0.5*dT*k1, u)
+        for (int i = 0; i < n; i++) {
+            Ksum[i] += 2.0f * K[i];
+            Xtmp[i] = x[i] + K[i] * dt2;
+        }
+        StateXdot(Xtmp, U, K); // k3 = f(x + 0.5*dT*k2, u)
+        for (int i = 0; i < n; i++) {
+            Ksum[i] += 2.0f * K[i];
+            Xtmp[i] = x[i] + K[i] * dt;
+        }
+        StateXdot(Xtmp, U, K); // k4 = f(x + dT * k3, u)
 
-    // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
-    x = Xlast + (K1 + 2.0f * K2 + 2.0f * K3 + K4) * (dt / 6.0f);
+        // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
+        float dt6 = dt / 6.0f;
+        for (int i = 0; i < n; i++) {
+            x[i] += (Ksum[i] + K[i]) * dt6;
+        }
+        break;
+    }
+    }
 }
 
 dspm::Mat ekf::SkewSym4x4(float w[3])
@@ -147,42 +192,70 @@ void ekf::CovariancePrediction(float dt)
 
 void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
 {
-    float HPHR, Error;
-    dspm::Mat Y(measured, H.rows, 1);
-    dspm::Mat Z(expected, H.rows, 1);
+    this->UpdateSequential(H.data, H.stride, H.rows, measured, expected, R);
+}
 
-    for (int m = 0; m < H.rows; m++) {
-        for (int j = 0; j < this->NUMX; j++) {
-            // Find Hp = H*P
-            HP[j] = 0;
-        }
-        for (int k = 0; k < this->NUMX; k++) {
-            for (int j = 0; j < this->NUMX; j++) {
-                // Find Hp = H*P
-                HP[j] += H(m, k) * P(k, j);
-            }
-        }
-        HPHR = R[m]; // Find  HPHR = H*P*H' + R
-        for (int k = 0; k < this->NUMX; k++) {
-            HPHR += HP[k] * H(m, k);
-        }
-        float invHPHR = 1.0f / HPHR;
-        for (int k = 0; k < this->NUMX; k++) {
-            Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
-        }
-        for (int i = 0; i < this->NUMX; i++) {
-            // Find P(m)= P(m-1) + K*HP
-            for (int j = i; j < NUMX; j++) {
-                P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
-            }
+void ekf::UpdateSequential(const float *H, int H_stride, int rows, const float *measured, const float *expected, const float *R)
+{
+    for (int m = 0; m < rows; m++) {
+        this->UpdateScalar(&H[m * H_stride], measured[m] - expected[m], R[m]);
+    }
+}
+
+void ekf::UpdateScalar(const float *h, float error, float R)
+{
+    const int n = this->NUMX;
+    const int p_stride = this->P.stride;
+    float *p = this->P.data;
+    float *x = this->X.data;
+
+    // Collect non zero elements of h, the H rows of IMU models are mostly empty
+    int nnz = 0;
+    for (int k = 0; k < n; k++) {
+        if (h[k] != 0) {
+            Hnz[nnz++] = k;
         }
+    }
+    if (nnz == 0) {
+        return;
+    }
 
-        Error = Y(m, 0) - Z(m, 0);
-        for (int i = 0; i < this->NUMX; i++) {
-            // Find X(m)= X(m-1) + K*Error
-            X(i, 0) = X(i, 0) + Km[i] * Error;
+    // Find HP = h*P
+    for (int j = 0; j < n; j++) {
+        HP[j] = 0;
+    }
+    for (int i = 0; i < nnz; i++) {
+        int k = Hnz[i];
+        float hk = h[k];
+        const float *p_row = &p[k * p_stride];
+        for (int j = 0; j < n; j++) {
+            HP[j] += hk * p_row[j];
+        }
+    }
+    // Find HPHR = h*P*h' + R
+    float HPHR = R;
+    for (int i = 0; i < nnz; i++) {
+        HPHR += HP[Hnz[i]] * h[Hnz[i]];
+    }
+    // Find K = HP/HPHR
+    float invHPHR = 1.0f / HPHR;
+    for (int k = 0; k < n; k++) {
+        Km[k] = HP[k] * invHPHR;
+    }
+    // Find P(m) = P(m-1) - K*HP, only upper triangle is calculated
+    for (int i = 0; i < n; i++) {
+        float ki = Km[i];
+        float *p_row = &p[i * p_stride];
+        for (int j = i; j < n; j++) {
+            float v = p_row[j] - ki * HP[j];
+            p_row[j] = v;
+            p[j * p_stride + i] = v;
         }
     }
+    // Find X(m) = X(m-1) + K*Error
+    for (int i = 0; i < n; i++) {
+        x[i] += Km[i] * error;
+    }
 }
 
 void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
@@ -407,6 +480,15 @@ dspm::Mat ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q)
     return result;
 }
 
+void ekf::StateXdot(float *x, float *u, float *xdot)
+{
+    dspm::Mat X_(x, this->NUMX, 1);
+    dspm::Mat Xdot = StateXdot(X_, u);
+    for (int i = 0; i < this->NUMX; i++) {
+        xdot[i] = Xdot.data[i];
+    }
+}
+
 dspm::Mat ekf::StateXdot(dspm::Mat &x, float *u)
 {
     dspm::Mat U(u, this->G.cols, 1);
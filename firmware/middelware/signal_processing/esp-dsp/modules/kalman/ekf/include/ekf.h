@@ -91,6 +91,20 @@ public:
     */
     dspm::Mat &Q;
 
+    /**
+     * Integration methods for the state update.
+     */
+    enum Integrator {
+        Euler = 0,  /*!< Forward Euler, 1 StateXdot call per step */
+        RK2 = 1,    /*!< Runge-Kutta 2nd order (midpoint), 2 StateXdot calls per step */
+        RK4 = 2,    /*!< Runge-Kutta 4th order, 4 StateXdot calls per step */
+    };
+
+    /**
+     * Integration method used by Process(). Default is RK4.
+    */
+    Integrator integrator;
+
     /**
      * Runge-Kutta state update method.
      * The method calculates derivatives of input vector x and control measurements u
@@ -101,6 +115,17 @@ public:
      */
     void RungeKutta(dspm::Mat &x, float *u, float dt);
 
+    /**
+     * State update with selected integration method.
+     * The method uses preallocated workspace and does not allocate memory.
+     *
+     * @param[in/out] x: state vector, NUMX values
+     * @param[in] u: control measurement
+     * @param[in] dt: time interval from last update in seconds
+     * @param[in] method: integration method
+     */
+    void Integrate(float *x, float *u, float dt, Integrator method);
+
     // System Dependent methods:
 
     /**
@@ -112,6 +137,15 @@ public:
      *      - derivative of input vector x and u
      */
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    /**
+     * Derivative of state vector X, stored to the provided buffer.
+     * Default implementation calls the Mat version of StateXdot().
+     * Models should override this method to avoid memory allocation.
+     * @param[in] x: state vector, NUMX values
+     * @param[in] u: control measurement
+     * @param[out] xdot: derivative of state vector, NUMX values
+     */
+    virtual void StateXdot(float *x, float *u, float *xdot);
     /**
      * Calculation of system state matrices F and G
      * @param[in] x: state vector
@@ -139,6 +173,26 @@ public:
      * @param[in] R: measurement noise covariance values
      */
     virtual void Update(dspm::Mat &H, float *measured, float *expected, float *R);
+    /**
+     * Update of current state by a batch of independent scalar measurements.
+     * Allocation free version of Update() for diagonal measurement noise.
+     * Every row of H is processed as a separate scalar measurement, the
+     * zero entries of the row are skipped, and HP/Km are used as scratch.
+     * @param[in] H: derivative matrix data, rows x NUMX values
+     * @param[in] H_stride: distance between two rows of H in elements
+     * @param[in] rows: amount of measurements (rows of H)
+     * @param[in] measured: array of measured values
+     * @param[in] expected: array of expected values
+     * @param[in] R: measurement noise covariance values
+     */
+    void UpdateSequential(const float *H, int H_stride, int rows, const float *measured, const float *expected, const float *R);
+    /**
+     * Update of current state by one scalar measurement.
+     * @param[in] h: row of derivative matrix, NUMX values
+     * @param[in] error: difference between measured and expected value
+     * @param[in] R: measurement noise covariance value
+     */
+    void UpdateScalar(const float *h, float error, float R);
     /**
      * Update of current state by measured values.
      * This method just as a reference for research purpose.
@@ -158,6 +212,14 @@ public:
      * Matrix for intermidieve calculations
     */
     float *Km;
+    /**
+     * Indexes of non zero elements of the current H row
+    */
+    int *Hnz;
+    /**
+     * Workspace for integration: derivative, accumulator and intermediate state
+    */
+    float *Kx;
 
 public:
     // Additional universal helper methods
@@ -52,23 +52,28 @@ void ekf_imu13states::Init()
 
 dspm::Mat ekf_imu13states::StateXdot(dspm::Mat &x, float *u)
 {
-    float wx = u[0] - x(4, 0); // subtract the biases on gyros
-    float wy = u[1] - x(5, 0);
-    float wz = u[2] - x(6, 0);
-
-    float w[] = {wx, wy, wz};
-    dspm::Mat q = dspm::Mat(x.data, 4, 1);
-
-    // qdot = Q * w
-    dspm::Mat Omega = 0.5 * SkewSym4x4(w);
-    dspm::Mat qdot = Omega * q;
     dspm::Mat Xdot(this->NUMX, 1);
-    Xdot *= 0;
-    Xdot.Copy(qdot, 0, 0);
+    StateXdot(x.data, u, Xdot.data);
+    return Xdot;
+}
+
+void ekf_imu13states::StateXdot(float *x, float *u, float *xdot)
+{
+    float wx = u[0] - x[4]; // subtract the biases on gyros
+    float wy = u[1] - x[5];
+    float wz = u[2] - x[6];
+
+    // qdot = 0.5 * SkewSym4x4(w) * q
+    xdot[0] = 0.5f * (-wx * x[1] - wy * x[2] - wz * x[3]);
+    xdot[1] = 0.5f * (wx * x[0] + wz * x[2] - wy * x[3]);
+    xdot[2] = 0.5f * (wy * x[0] - wz * x[1] + wx * x[3]);
+    xdot[3] = 0.5f * (wz * x[0] + wy * x[1] - wx * x[2]);
     // dwbias = 0
     // dMang_Ampl = 0
     // dMang_offset = 0
-    return Xdot;
+    for (int i = 4; i < this->NUMX; i++) {
+        xdot[i] = 0;
+    }
 }
 
 void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
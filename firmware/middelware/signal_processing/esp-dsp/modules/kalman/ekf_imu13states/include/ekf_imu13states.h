@@ -37,6 +37,7 @@ public:
     // Method calculates Xdot values depends on U
     // U - gyroscope values in radian per seconds (rad/sec)
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    virtual void StateXdot(float *x, float *u, float *xdot);
     virtual void LinearizeFG(dspm::Mat &x, float *u);
 
     /**
@@ -58,3 +58,89 @@ TEST_CASE("ekf_imu13states functionality gyro and magn", "[dspm]")
     printf("Expected result = %i, calculated result = %i\n", 200, (int)(1000 * ekf13->X.data[5] + 0.5));
     printf("Expected result = %i, calculated result = %i\n", 300, (int)(1000 * ekf13->X.data[6] + 0.5));
 }
+
+TEST_CASE("ekf UpdateSequential compare to UpdateRef", "[dspm]")
+{
+    ekf_imu13states *ekf_seq = new ekf_imu13states();
+    ekf_imu13states *ekf_ref = new ekf_imu13states();
+    ekf_seq->Init();
+    ekf_ref->Init();
+    int N = ekf_seq->NUMX;
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            float v = (i == j) ? 0.1f : 0.01f / (1 + abs(i - j));
+            ekf_seq->P(i, j) = v;
+            ekf_ref->P(i, j) = v;
+        }
+    }
+    // Sparse H: only quaternion part and a few magnetometer states are used
+    dspm::Mat H(6, N);
+    H *= 0;
+    for (int m = 0; m < 6; m++) {
+        for (int k = 0; k < 4; k++) {
+            H(m, k) = 0.1f * (((m * 7 + k * 3) % 5) - 2);
+        }
+        H(m, 7 + (m % 6)) = 1;
+    }
+    float measured[6] = {0.9, 0.1, -0.1, 0.05, 0.02, 1.0};
+    float expected[6] = {1.0, 0.0, 0.0, 0.0, 0.0, 0.9};
+    float R[6] = {0.01, 0.01, 0.01, 0.02, 0.02, 0.02};
+
+    unsigned int start_b = xthal_get_ccount();
+    ekf_seq->UpdateSequential(H.data, H.stride, H.rows, measured, expected, R);
+    unsigned int end_b = xthal_get_ccount();
+    // Reference: full matrix update applied for every measurement
+    for (int m = 0; m < H.rows; m++) {
+        dspm::Mat Hm = H.Get(m, 1, 0, N);
+        ekf_ref->UpdateRef(Hm, &measured[m], &expected[m], &R[m]);
+    }
+    ESP_LOGI(TAG, "UpdateSequential takes %i cycles", (int)(end_b - start_b));
+
+    for (int i = 0; i < N; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, ekf_ref->X(i, 0), ekf_seq->X(i, 0));
+        for (int j = 0; j < N; j++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4, ekf_ref->P(i, j), ekf_seq->P(i, j));
+        }
+    }
+    delete ekf_seq;
+    delete ekf_ref;
+}
+
+TEST_CASE("ekf Integrate Euler/RK2/RK4 accuracy", "[dspm]")
+{
+    // Constant rotation around X axis, analytic result: q = [cos(w*t/2), sin(w*t/2), 0, 0]
+    float w = 2.0f;
+    float dt = 0.01f;
+    int steps = 100;
+    float u[3] = {w, 0, 0};
+    float expected_w = cosf(w * dt * steps / 2);
+    float expected_x = sinf(w * dt * steps / 2);
+    ekf::Integrator methods[] = {ekf::Euler, ekf::RK2, ekf::RK4};
+    float errors[3];
+
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf13->Init();
+    for (int m = 0; m < 3; m++) {
+        ekf13->X *= 0;
+        ekf13->X.data[0] = 1;
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < steps; i++) {
+            ekf13->Integrate(ekf13->X.data, u, dt, methods[m]);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        errors[m] = fabsf(ekf13->X.data[0] - expected_w) + fabsf(ekf13->X.data[1] - expected_x);
+        ESP_LOGI(TAG, "Integrator %i: error = %e, %i cycles per step", m, errors[m], (int)((end_b - start_b) / steps));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-2, 0, errors[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0, errors[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0, errors[2]);
+
+    // RungeKutta keeps the original RK4 behavior
+    ekf13->X *= 0;
+    ekf13->X.data[0] = 1;
+    for (int i = 0; i < steps; i++) {
+        ekf13->RungeKutta(ekf13->X, u, dt);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0, fabsf(ekf13->X.data[0] - expected_w) + fabsf(ekf13->X.data[1] - expected_x));
+    delete ekf13;
+}
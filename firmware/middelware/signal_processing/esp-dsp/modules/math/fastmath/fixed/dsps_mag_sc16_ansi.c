@@ -0,0 +1,74 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+
+// Rounded integer square root, bit by bit
+static inline uint32_t isqrt32(uint32_t x)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    // x is now the remainder input - result^2
+    if (x > result) {
+        result++;
+    }
+    return result;
+}
+
+esp_err_t dsps_mag_sc16_ansi(const int16_t *input, int16_t *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    // Forward order allows output == input
+    for (int i = 0 ; i < len ; i++) {
+        int32_t re = input[i * 2 + 0];
+        int32_t im = input[i * 2 + 1];
+        uint32_t mag = isqrt32((uint32_t)(re * re) + (uint32_t)(im * im));
+        output[i] = mag > INT16_MAX ? INT16_MAX : (int16_t)mag;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_power_sc16_ansi(const int16_t *input, int32_t *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        int32_t re = input[i * 2 + 0];
+        int32_t im = input[i * 2 + 1];
+        uint32_t power = (uint32_t)(re * re) + (uint32_t)(im * im);
+        output[i] = power > INT32_MAX ? INT32_MAX : (int32_t)power;
+    }
+    return ESP_OK;
+}
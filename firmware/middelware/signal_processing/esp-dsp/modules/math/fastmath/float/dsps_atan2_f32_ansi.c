@@ -0,0 +1,64 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include <math.h>
+
+#define PI_F            3.14159265358979323846f
+#define PI_2_F          1.57079632679489661923f
+#define PI_4_F          0.78539816339744830962f
+#define TAN_PI_8        0.414213562373095048802f
+
+// atan(t) for t = [0..1]
+static inline float atan_kernel(float t)
+{
+    float offset = 0;
+    if (t > TAN_PI_8) {
+        t = (t - 1.0f) / (t + 1.0f);
+        offset = PI_4_F;
+    }
+    float z = t * t;
+    return offset + (((8.05374449538e-2f * z
+                       - 1.38776856032E-1f) * z
+                      + 1.99777106478E-1f) * z
+                     - 3.33329491539E-1f) * z * t + t;
+}
+
+esp_err_t dsps_atan2_f32_ansi(const float *y, const float *x, float *output, int len)
+{
+    if ((NULL == y) || (NULL == x)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        float xi = x[i];
+        float yi = y[i];
+        float ax = fabsf(xi);
+        float ay = fabsf(yi);
+        float a;
+        if (ay > ax) {
+            a = PI_2_F - atan_kernel(ax / ay);
+        } else if (ax > 0) {
+            a = atan_kernel(ay / ax);
+        } else {
+            a = 0; // x = y = 0
+        }
+        if (signbit(xi)) {
+            a = PI_F - a;
+        }
+        output[i] = signbit(yi) ? -a : a;
+    }
+    return ESP_OK;
+}
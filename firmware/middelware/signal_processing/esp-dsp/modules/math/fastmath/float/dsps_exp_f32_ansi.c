@@ -0,0 +1,73 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include <math.h>
+
+#define EXP_MAX_ARG     88.7228391f     // log(FLT_MAX)
+#define EXP_MIN_ARG     -87.3365448f    // log(FLT_MIN)
+#define LOG2E           1.44269504088896341f
+#define LN2_HI          0.693359375f    // 9 bits, n * LN2_HI is exact
+#define LN2_LO          -2.12194440e-4f
+
+float dsps_expf_f32_ansi(float data)
+{
+    if (data != data) {
+        return data;
+    }
+    if (data > EXP_MAX_ARG) {
+        return INFINITY;
+    }
+    if (data < EXP_MIN_ARG) {
+        return 0.0f;
+    }
+    // exp(x) = 2^n * exp(r), |r| <= ln2/2
+    float fn = data * LOG2E;
+    int n = (int)(fn + ((fn >= 0) ? 0.5f : -0.5f));
+    float r = data - n * LN2_HI;
+    r = r - n * LN2_LO;
+
+    float z = r * r;
+    float p = ((((( 1.9875691500E-4f * r
+                    + 1.3981999507E-3f) * r
+                  + 8.3334519073E-3f) * r
+                + 4.1665795894E-2f) * r
+              + 1.6666665459E-1f) * r
+             + 5.0000001201E-1f) * z + r + 1.0f;
+
+    // Scale by 2^n, n = 128 is split to stay in the exponent range
+    union {
+        float f;
+        int32_t i;
+    } scale;
+    if (n > 127) {
+        p *= 2.0f;
+        n--;
+    }
+    scale.i = (n + 127) << 23;
+    return p * scale.f;
+}
+
+esp_err_t dsps_exp_f32_ansi(const float *input, float *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        output[i] = dsps_expf_f32_ansi(input[i]);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,83 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include <math.h>
+
+#define SQRT_HALF       0.707106781186547524f
+#define LN2_HI          0.693359375f
+#define LN2_LO          -2.12194440e-4f
+
+float dsps_logf_f32_ansi(float data)
+{
+    union {
+        float f;
+        int32_t i;
+    } conv = {data};
+
+    if (conv.i <= 0) {
+        // -0 and +0 give -INFINITY, negative values give NaN
+        return ((conv.i & 0x7fffffff) == 0) ? -INFINITY : NAN;
+    }
+    if (conv.i >= 0x7f800000) {
+        return data; // +INFINITY or NaN
+    }
+    int e = 0;
+    if (conv.i < 0x00800000) {
+        // Denormal value, normalize it first
+        conv.f *= 33554432.0f; // 2^25
+        e = -25;
+    }
+    // x = m * 2^e, m = [0.5..1)
+    e += ((conv.i >> 23) & 0xff) - 126;
+    conv.i = (conv.i & 0x007fffff) | 0x3f000000;
+    float x = conv.f;
+    if (x < SQRT_HALF) {
+        e -= 1;
+        x = x + x - 1.0f;
+    } else {
+        x = x - 1.0f;
+    }
+
+    // log(1 + x), x = [sqrt(0.5) - 1 .. sqrt(2) - 1)
+    float z = x * x;
+    float y = ((((((((7.0376836292E-2f * x
+                      - 1.1514610310E-1f) * x
+                     + 1.1676998740E-1f) * x
+                    - 1.2420140846E-1f) * x
+                   + 1.4249322787E-1f) * x
+                  - 1.6668057665E-1f) * x
+                 + 2.0000714765E-1f) * x
+                - 2.4999993993E-1f) * x
+               + 3.3333331174E-1f) * x * z;
+    float fe = (float)e;
+    y += LN2_LO * fe;
+    y += -0.5f * z;
+    x = x + y;
+    x += LN2_HI * fe;
+    return x;
+}
+
+esp_err_t dsps_log_f32_ansi(const float *input, float *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        output[i] = dsps_logf_f32_ansi(input[i]);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,50 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include <math.h>
+
+#define LOG10E          0.434294481903251827651f
+
+esp_err_t dsps_mag_fc32_ansi(const float *input, float *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    // Forward order allows output == input
+    for (int i = 0 ; i < len ; i++) {
+        float re = input[i * 2 + 0];
+        float im = input[i * 2 + 1];
+        output[i] = sqrtf(re * re + im * im);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_db_f32_ansi(const float *input, float *output, int len, float factor)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    float k = factor * LOG10E;
+    for (int i = 0 ; i < len ; i++) {
+        output[i] = k * dsps_logf_f32_ansi(input[i]);
+    }
+    return ESP_OK;
+}
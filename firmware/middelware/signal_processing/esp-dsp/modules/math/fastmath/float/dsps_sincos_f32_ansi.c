@@ -0,0 +1,143 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include <math.h>
+
+#define TWO_OVER_PI     0.636619772367581343f
+// pi/2 = DP1 + DP2 + DP3, q * DP1 and q * DP2 are exact for q < 8192
+#define DP1             1.5703125f
+#define DP2             4.837512969970703125e-4f
+#define DP3             7.54978995489188216e-8f
+#define REDUCE_MAX      12800.0f    // Largest |x| with q < 8192
+#define TWO_PI          6.28318530717958648f
+
+// sin(r) and cos(r) for |r| <= pi/4
+static inline float sin_kernel(float r, float z)
+{
+    return ((-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f) * z * r + r;
+}
+
+static inline float cos_kernel(float z)
+{
+    return ((2.443315711809948E-5f * z - 1.388731625493765E-3f) * z + 4.166664568298827E-2f) * z * z - 0.5f * z + 1.0f;
+}
+
+// Reduce |x| to r = |x| - q * pi/2, returns the quadrant q
+static inline int reduce(float x, float *r)
+{
+    float ax = fabsf(x);
+    if (!(ax <= REDUCE_MAX)) {
+        if (!isfinite(ax)) {
+            // NaN result, the quadrant cast below would be undefined
+            *r = x - x;
+            return 0;
+        }
+        // Out of range, inaccurate but keeps q small
+        ax = fmodf(ax, TWO_PI);
+    }
+    int q = (int)(ax * TWO_OVER_PI + 0.5f);
+    float fq = (float)q;
+    *r = ((ax - fq * DP1) - fq * DP2) - fq * DP3;
+    return q;
+}
+
+static inline void sincos_one(float x, float *s, float *c)
+{
+    float r;
+    int q = reduce(x, &r);
+    float z = r * r;
+    float sr = sin_kernel(r, z);
+    float cr = cos_kernel(z);
+    float sv, cv;
+    switch (q & 3) {
+    case 0:
+        sv = sr;
+        cv = cr;
+        break;
+    case 1:
+        sv = cr;
+        cv = -sr;
+        break;
+    case 2:
+        sv = -sr;
+        cv = -cr;
+        break;
+    default:
+        sv = -cr;
+        cv = sr;
+        break;
+    }
+    *s = (x < 0) ? -sv : sv;
+    *c = cv;
+}
+
+esp_err_t dsps_sin_f32_ansi(const float *input, float *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        float x = input[i];
+        float r;
+        int q = reduce(x, &r);
+        float z = r * r;
+        float v = (q & 1) ? cos_kernel(z) : sin_kernel(r, z);
+        if (q & 2) {
+            v = -v;
+        }
+        output[i] = (x < 0) ? -v : v;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_cos_f32_ansi(const float *input, float *output, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        float r;
+        int q = reduce(input[i], &r);
+        float z = r * r;
+        float v = (q & 1) ? sin_kernel(r, z) : cos_kernel(z);
+        // cos(r + q*pi/2): q = 1, 2 negative
+        if (((q + 1) & 3) > 1) {
+            v = -v;
+        }
+        output[i] = v;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_sincos_f32_ansi(const float *input, float *out_sin, float *out_cos, int len)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((NULL == out_sin) || (NULL == out_cos)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    for (int i = 0 ; i < len ; i++) {
+        sincos_one(input[i], &out_sin[i], &out_cos[i]);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,259 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fastmath_H_
+#define _dsps_fastmath_H_
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Elementwise approximations of elementary functions for float arrays.
+ * Polynomial approximations with range reduction, no libm calls per element
+ * (except sqrtf in magnitude). Accuracy tiers, measured against libm:
+ *
+ *  | Function              | Input range                  | Max error                  |
+ *  |-----------------------|------------------------------|----------------------------|
+ *  | dsps_exp_f32          | [-87.3 .. 88.7]              | 2 ULP                      |
+ *  | dsps_log_f32          | (0 .. FLT_MAX]               | 2 ULP                      |
+ *  | dsps_sin/cos_f32      | [-8192 .. 8192]              | 2.5e-7 absolute            |
+ *  | dsps_atan2_f32        | finite values                | 3.5e-7 rad absolute        |
+ *  | dsps_mag_fc32         | finite values                | 1.5 ULP                    |
+ *  | dsps_db_f32           | result in [-100 .. 100] dB   | 2e-5 dB absolute           |
+ *
+ * Outside of the input range exp saturates to 0/INFINITY, log returns -INFINITY
+ * for zero and NaN for negative values, sin/cos lose accuracy (results stay in
+ * [-1 .. 1]) and return NaN for infinite or NaN inputs.
+ * All array functions accept output == input.
+ */
+
+/**@{*/
+/**
+ * @brief   exponent approximation
+ *
+ * result ~ exp(data)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] data: input value
+ *
+ * @return
+ *      - exponent value
+ */
+float dsps_expf_f32_ansi(float data);
+
+/**
+ * @brief   natural logarithm approximation
+ *
+ * result ~ log(data)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] data: input value
+ *
+ * @return
+ *      - natural logarithm value
+ */
+float dsps_logf_f32_ansi(float data);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   exponent of array
+ *
+ * output[i] ~ exp(input[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_exp_f32_ansi(const float *input, float *output, int len);
+
+/**
+ * @brief   natural logarithm of array
+ *
+ * output[i] ~ log(input[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_log_f32_ansi(const float *input, float *output, int len);
+
+/**
+ * @brief   sine of array
+ *
+ * output[i] ~ sin(input[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, radians
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sin_f32_ansi(const float *input, float *output, int len);
+
+/**
+ * @brief   cosine of array
+ *
+ * output[i] ~ cos(input[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, radians
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cos_f32_ansi(const float *input, float *output, int len);
+
+/**
+ * @brief   sine and cosine of array
+ *
+ * The range reduction is shared between both results.
+ * out_sin[i] ~ sin(input[i]), out_cos[i] ~ cos(input[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, radians
+ * @param out_sin: output array for sine
+ * @param out_cos: output array for cosine
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sincos_f32_ansi(const float *input, float *out_sin, float *out_cos, int len);
+
+/**
+ * @brief   four-quadrant arctangent of arrays
+ *
+ * output[i] ~ atan2(y[i], x[i]); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] y: input array with y coordinates
+ * @param[in] x: input array with x coordinates
+ * @param output: output array, radians in range [-pi..pi]
+ * @param len: amount of operations for arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_atan2_f32_ansi(const float *y, const float *x, float *output, int len);
+
+/**
+ * @brief   magnitude of complex array
+ *
+ * output[i] = sqrt(input[2*i]^2 + input[2*i + 1]^2); i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input complex array (re, im pairs), 2*len values
+ * @param output: output array, could be the same as input
+ * @param len: amount of complex values
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mag_fc32_ansi(const float *input, float *output, int len);
+
+/**
+ * @brief   magnitude of Q15 complex array
+ *
+ * output[i] = sqrt(input[2*i]^2 + input[2*i + 1]^2); i=[0..len)
+ * Integer only, result is rounded and saturated to INT16_MAX. Block exponent of the input
+ * (for example from dsps_fft2r_sc16_bfp) applies unchanged to the output.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input complex array (re, im pairs), 2*len values
+ * @param output: output array, could be the same as input
+ * @param len: amount of complex values
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mag_sc16_ansi(const int16_t *input, int16_t *output, int len);
+
+/**
+ * @brief   power of Q15 complex array
+ *
+ * output[i] = input[2*i]^2 + input[2*i + 1]^2; i=[0..len)
+ * Result is Q30, saturated to INT32_MAX. For block exponent e of the input the
+ * exponent of the output is 2*e.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input complex array (re, im pairs), 2*len values
+ * @param output: output array
+ * @param len: amount of complex values
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_power_sc16_ansi(const int16_t *input, int32_t *output, int len);
+
+/**
+ * @brief   decibel conversion of array
+ *
+ * output[i] ~ factor * log10(input[i]); i=[0..len)
+ * Use factor = 20 for amplitude (magnitude) values and factor = 10 for power values.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param factor: 10 for power, 20 for amplitude
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_db_f32_ansi(const float *input, float *output, int len, float factor);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#define dsps_expf_f32 dsps_expf_f32_ansi
+#define dsps_logf_f32 dsps_logf_f32_ansi
+#define dsps_exp_f32 dsps_exp_f32_ansi
+#define dsps_log_f32 dsps_log_f32_ansi
+#define dsps_sin_f32 dsps_sin_f32_ansi
+#define dsps_cos_f32 dsps_cos_f32_ansi
+#define dsps_sincos_f32 dsps_sincos_f32_ansi
+#define dsps_atan2_f32 dsps_atan2_f32_ansi
+#define dsps_mag_fc32 dsps_mag_fc32_ansi
+#define dsps_mag_sc16 dsps_mag_sc16_ansi
+#define dsps_power_sc16 dsps_power_sc16_ansi
+#define dsps_db_f32 dsps_db_f32_ansi
+
+#endif // _dsps_fastmath_H_
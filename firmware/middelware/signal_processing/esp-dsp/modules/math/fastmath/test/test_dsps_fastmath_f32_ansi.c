@@ -0,0 +1,258 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fastmath.h"
+#include "esp_attr.h"
+
+static const char *TAG = "dsps_fastmath";
+
+#define N_POINTS    1024
+
+// Error in units of last place of the float reference value
+static float ulp_error(float value, double reference)
+{
+    float ref_f = (float)reference;
+    float ulp = nextafterf(fabsf(ref_f), INFINITY) - fabsf(ref_f);
+    return (float)(fabs((double)value - reference) / ulp);
+}
+
+static float rand_range(float min, float max)
+{
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+TEST_CASE("dsps_exp_f32_ansi accuracy", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS);
+    float *y = (float *)malloc(sizeof(float) * N_POINTS);
+    float max_ulp = 0;
+    for (int k = 0; k < 100; k++) {
+        for (int i = 0; i < N_POINTS; i++) {
+            x[i] = rand_range(-87.3f, 88.7f);
+        }
+        dsps_exp_f32_ansi(x, y, N_POINTS);
+        for (int i = 0; i < N_POINTS; i++) {
+            float err = ulp_error(y[i], exp((double)x[i]));
+            if (err > max_ulp) {
+                max_ulp = err;
+            }
+        }
+    }
+    ESP_LOGI(TAG, "dsps_exp_f32_ansi: max error = %f ULP", max_ulp);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0, max_ulp);
+    TEST_ASSERT_EQUAL(0, dsps_expf_f32_ansi(-100));
+    TEST_ASSERT_TRUE(isinf(dsps_expf_f32_ansi(100)));
+    TEST_ASSERT_EQUAL(1, dsps_expf_f32_ansi(0));
+    free(x);
+    free(y);
+}
+
+TEST_CASE("dsps_log_f32_ansi accuracy", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS);
+    float *y = (float *)malloc(sizeof(float) * N_POINTS);
+    float max_ulp = 0;
+    for (int k = 0; k < 100; k++) {
+        for (int i = 0; i < N_POINTS; i++) {
+            // Log-uniform over the whole positive range, including denormals
+            x[i] = expf(rand_range(-100.0f, 88.0f));
+        }
+        dsps_log_f32_ansi(x, y, N_POINTS);
+        for (int i = 0; i < N_POINTS; i++) {
+            float err = ulp_error(y[i], log((double)x[i]));
+            if (err > max_ulp) {
+                max_ulp = err;
+            }
+        }
+    }
+    ESP_LOGI(TAG, "dsps_log_f32_ansi: max error = %f ULP", max_ulp);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0, max_ulp);
+    TEST_ASSERT_EQUAL(0, dsps_logf_f32_ansi(1));
+    TEST_ASSERT_TRUE(isinf(dsps_logf_f32_ansi(0)));
+    TEST_ASSERT_TRUE(isnan(dsps_logf_f32_ansi(-1)));
+    free(x);
+    free(y);
+}
+
+TEST_CASE("dsps_sincos_f32_ansi accuracy", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS);
+    float *s = (float *)malloc(sizeof(float) * N_POINTS);
+    float *c = (float *)malloc(sizeof(float) * N_POINTS);
+    float *s2 = (float *)malloc(sizeof(float) * N_POINTS);
+    float *c2 = (float *)malloc(sizeof(float) * N_POINTS);
+    float max_err = 0;
+    for (int k = 0; k < 100; k++) {
+        for (int i = 0; i < N_POINTS; i++) {
+            x[i] = rand_range(-8192.0f, 8192.0f) / (k + 1);
+        }
+        dsps_sincos_f32_ansi(x, s, c, N_POINTS);
+        dsps_sin_f32_ansi(x, s2, N_POINTS);
+        dsps_cos_f32_ansi(x, c2, N_POINTS);
+        for (int i = 0; i < N_POINTS; i++) {
+            float err_s = fabs(s[i] - sin((double)x[i]));
+            float err_c = fabs(c[i] - cos((double)x[i]));
+            max_err = fmaxf(max_err, fmaxf(err_s, err_c));
+            TEST_ASSERT_EQUAL(s[i], s2[i]);
+            TEST_ASSERT_EQUAL(c[i], c2[i]);
+        }
+    }
+    ESP_LOGI(TAG, "dsps_sincos_f32_ansi: max absolute error = %e", max_err);
+    TEST_ASSERT_FLOAT_WITHIN(2.5e-7f, 0, max_err);
+    // Out of range values stay bounded, non finite values give NaN
+    x[0] = 1e30f;
+    x[1] = -3e9f;
+    x[2] = INFINITY;
+    x[3] = NAN;
+    dsps_sincos_f32_ansi(x, s, c, 4);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, 0, s[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, 0, c[i]);
+    }
+    TEST_ASSERT_TRUE(isnan(s[2]) && isnan(c[2]));
+    TEST_ASSERT_TRUE(isnan(s[3]) && isnan(c[3]));
+    free(x);
+    free(s);
+    free(c);
+    free(s2);
+    free(c2);
+}
+
+TEST_CASE("dsps_atan2_f32_ansi accuracy", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS);
+    float *y = (float *)malloc(sizeof(float) * N_POINTS);
+    float *a = (float *)malloc(sizeof(float) * N_POINTS);
+    float max_err = 0;
+    for (int k = 0; k < 100; k++) {
+        for (int i = 0; i < N_POINTS; i++) {
+            x[i] = rand_range(-10.0f, 10.0f);
+            y[i] = rand_range(-10.0f, 10.0f);
+        }
+        x[0] = 0;
+        y[0] = 0;
+        x[1] = 0;
+        y[1] = -1;
+        dsps_atan2_f32_ansi(y, x, a, N_POINTS);
+        for (int i = 0; i < N_POINTS; i++) {
+            float err = fabs(a[i] - atan2((double)y[i], (double)x[i]));
+            max_err = fmaxf(max_err, err);
+        }
+    }
+    ESP_LOGI(TAG, "dsps_atan2_f32_ansi: max absolute error = %e", max_err);
+    TEST_ASSERT_FLOAT_WITHIN(3.5e-7f, 0, max_err);
+    free(x);
+    free(y);
+    free(a);
+}
+
+TEST_CASE("dsps_mag_fc32_ansi and dsps_db_f32_ansi functionality", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS * 2);
+    float *m = (float *)malloc(sizeof(float) * N_POINTS);
+    for (int i = 0; i < N_POINTS; i++) {
+        x[2 * i + 0] = rand_range(-1000.0f, 1000.0f);
+        x[2 * i + 1] = rand_range(-1000.0f, 1000.0f);
+    }
+    dsps_mag_fc32_ansi(x, m, N_POINTS);
+    for (int i = 0; i < N_POINTS; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1.5f, 0, ulp_error(m[i], hypot(x[2 * i], x[2 * i + 1])));
+    }
+    // In place
+    dsps_mag_fc32_ansi(x, x, N_POINTS);
+    for (int i = 0; i < N_POINTS; i++) {
+        TEST_ASSERT_EQUAL(m[i], x[i]);
+    }
+    float max_err = 0;
+    for (int k = 0; k < 100; k++) {
+        // Whole documented range, results in [-100 .. 100] dB
+        for (int i = 0; i < N_POINTS; i++) {
+            m[i] = powf(10.0f, rand_range(-5.0f, 5.0f));
+        }
+        dsps_db_f32_ansi(m, x, N_POINTS, 20);
+        for (int i = 0; i < N_POINTS; i++) {
+            max_err = fmaxf(max_err, fabs(x[i] - 20 * log10((double)m[i])));
+        }
+    }
+    ESP_LOGI(TAG, "dsps_db_f32_ansi: max absolute error = %e dB", max_err);
+    TEST_ASSERT_FLOAT_WITHIN(2e-5f, 0, max_err);
+    free(x);
+    free(m);
+}
+
+TEST_CASE("dsps_fastmath benchmark", "[dsps]")
+{
+    float *x = (float *)malloc(sizeof(float) * N_POINTS);
+    float *x2 = (float *)malloc(sizeof(float) * N_POINTS);
+    float *y = (float *)malloc(sizeof(float) * N_POINTS);
+    float *y2 = (float *)malloc(sizeof(float) * N_POINTS);
+    for (int i = 0; i < N_POINTS; i++) {
+        x[i] = rand_range(0.01f, 10.0f);
+        x2[i] = rand_range(-10.0f, 10.0f);
+    }
+    unsigned int start_b, end_b;
+    unsigned int libm_cycles, dsp_cycles;
+
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < N_POINTS; i++) {
+        y[i] = expf(x[i]);
+    }
+    libm_cycles = xthal_get_ccount() - start_b;
+    start_b = xthal_get_ccount();
+    dsps_exp_f32_ansi(x, y, N_POINTS);
+    dsp_cycles = xthal_get_ccount() - start_b;
+    ESP_LOGI(TAG, "exp: libm %f, dsps %f cycles per sample", (float)libm_cycles / N_POINTS, (float)dsp_cycles / N_POINTS);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < N_POINTS; i++) {
+        y[i] = logf(x[i]);
+    }
+    libm_cycles = xthal_get_ccount() - start_b;
+    start_b = xthal_get_ccount();
+    dsps_log_f32_ansi(x, y, N_POINTS);
+    dsp_cycles = xthal_get_ccount() - start_b;
+    ESP_LOGI(TAG, "log: libm %f, dsps %f cycles per sample", (float)libm_cycles / N_POINTS, (float)dsp_cycles / N_POINTS);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < N_POINTS; i++) {
+        y[i] = sinf(x2[i]);
+        y2[i] = cosf(x2[i]);
+    }
+    libm_cycles = xthal_get_ccount() - start_b;
+    start_b = xthal_get_ccount();
+    dsps_sincos_f32_ansi(x2, y, y2, N_POINTS);
+    dsp_cycles = xthal_get_ccount() - start_b;
+    ESP_LOGI(TAG, "sincos: libm %f, dsps %f cycles per sample", (float)libm_cycles / N_POINTS, (float)dsp_cycles / N_POINTS);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < N_POINTS; i++) {
+        y[i] = atan2f(x2[i], x[i]);
+    }
+    libm_cycles = xthal_get_ccount() - start_b;
+    start_b = xthal_get_ccount();
+    dsps_atan2_f32_ansi(x2, x, y, N_POINTS);
+    dsp_cycles = xthal_get_ccount() - start_b;
+    ESP_LOGI(TAG, "atan2: libm %f, dsps %f cycles per sample", (float)libm_cycles / N_POINTS, (float)dsp_cycles / N_POINTS);
+
+    free(x);
+    free(x2);
+    free(y);
+    free(y2);
+}
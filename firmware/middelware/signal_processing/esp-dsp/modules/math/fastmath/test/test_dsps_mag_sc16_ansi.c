@@ -0,0 +1,85 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fastmath.h"
+#include "esp_attr.h"
+
+static const char *TAG = "dsps_mag_sc16";
+
+#define N_POINTS    1024
+
+static int16_t input[N_POINTS * 2];
+static int16_t output[N_POINTS];
+static int32_t power[N_POINTS];
+
+TEST_CASE("dsps_mag_sc16_ansi functionality", "[dsps]")
+{
+    for (int i = 0 ; i < N_POINTS * 2 ; i++) {
+        input[i] = (int16_t)((rand() & 0xffff) - 0x8000);
+    }
+    // Corner cases
+    input[0] = INT16_MIN;
+    input[1] = INT16_MIN;
+    input[2] = 0;
+    input[3] = 0;
+    input[4] = 3;
+    input[5] = 4;
+
+    TEST_ESP_OK(dsps_power_sc16_ansi(input, power, N_POINTS));
+    TEST_ESP_OK(dsps_mag_sc16_ansi(input, output, N_POINTS));
+    for (int i = 0 ; i < N_POINTS ; i++) {
+        double p = (double)input[i * 2] * input[i * 2] + (double)input[i * 2 + 1] * input[i * 2 + 1];
+        double m = sqrt(p);
+        if (m > INT16_MAX) {
+            m = INT16_MAX;
+        }
+        if (p > INT32_MAX) {
+            p = INT32_MAX;
+        }
+        TEST_ASSERT_EQUAL((int32_t)p, power[i]);
+        TEST_ASSERT_MESSAGE(fabs(output[i] - m) <= 0.5, "Result out of range!");
+    }
+    TEST_ASSERT_EQUAL(INT16_MAX, output[0]);
+    TEST_ASSERT_EQUAL(0, output[1]);
+    TEST_ASSERT_EQUAL(5, output[2]);
+
+    // In place
+    TEST_ESP_OK(dsps_mag_sc16_ansi(input, input, N_POINTS));
+    TEST_ASSERT_EQUAL(0, memcmp(input, output, sizeof(output)));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_mag_sc16_ansi(NULL, output, N_POINTS));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_power_sc16_ansi(input, NULL, N_POINTS));
+}
+
+TEST_CASE("dsps_mag_sc16_ansi benchmark", "[dsps]")
+{
+    for (int i = 0 ; i < N_POINTS * 2 ; i++) {
+        input[i] = (int16_t)((rand() & 0xffff) - 0x8000);
+    }
+    unsigned int start_b = xthal_get_ccount();
+    dsps_mag_sc16_ansi(input, output, N_POINTS);
+    unsigned int end_b = xthal_get_ccount();
+    float cycles = (float)(end_b - start_b) / N_POINTS;
+    ESP_LOGI(TAG, "dsps_mag_sc16_ansi - %f cycles per sample", cycles);
+
+    start_b = xthal_get_ccount();
+    dsps_power_sc16_ansi(input, power, N_POINTS);
+    end_b = xthal_get_ccount();
+    cycles = (float)(end_b - start_b) / N_POINTS;
+    ESP_LOGI(TAG, "dsps_power_sc16_ansi - %f cycles per sample", cycles);
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_nco_H_
+#define _dsps_nco_H_
+
+#include "dsp_err.h"
+#include "dsps_cplx_gen.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief State of one tone of the NCO bank
+ *
+ * Phase is an unsigned 32 bit accumulator where 2^32 is related to 2Pi, so the
+ * phase wraps without any check and stays continuous between calls.
+ */
+typedef struct nco_tone_s {
+    uint32_t    phase;          /*!< Phase accumulator */
+    uint32_t    phase_inc;      /*!< Phase increment per sample (frequency) */
+    float       amplitude;      /*!< Amplitude for F32_FLOAT output */
+    int16_t     amplitude_q15;  /*!< Amplitude for S16_FIXED output */
+} nco_tone_t;
+
+/**
+ * @brief Data struct of the NCO bank
+ *
+ * All the fields of this structure are initialized by the dsps_nco_init(...) function.
+ */
+typedef struct nco_bank_s {
+    void       *lut;            /*!< Pointer to the sine lookup table (one period), shared by all tones */
+    int32_t     lut_len;        /*!< Length of the lookup table */
+    int32_t     lut_shift;      /*!< 32 - log2(lut_len), phase to LUT index shift */
+    nco_tone_t *tone;           /*!< Tones state */
+    int32_t     tones;          /*!< Amount of tones */
+    out_d_type  d_type;         /*!< Output data type */
+    int16_t     free_status;    /*!< Indicator for dsps_nco_free(...) function */
+} nco_bank_t;
+
+/**
+ * @brief Initialize the NCO bank
+ *
+ * All tones share one sine LUT, samples are linearly interpolated between the LUT entries.
+ * The LUT has the same format as the dsps_cplx_gen LUT (one sine period, Q15 or float), so one
+ * table could be shared by both generators. If the LUT pointer is NULL, the LUT is generated internally.
+ * All tones are initialized to zero frequency and amplitude.
+ * dsps_nco_free(...) must be called, once the bank is not needed anymore.
+ *
+ * @param nco: pointer to the NCO bank structure
+ * @param d_type: output data type - out_d_type enum
+ * @param lut: pointer to a user-defined LUT or NULL
+ * @param lut_len: length of the LUT, power of 2 (256..8192 for the internal LUT)
+ * @param tones: amount of tones
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_init(nco_bank_t *nco, out_d_type d_type, void *lut, int32_t lut_len, int32_t tones);
+
+/**
+ * @brief Set frequency, phase and amplitude of one tone
+ *
+ * @param nco: pointer to the NCO bank structure
+ * @param index: tone index
+ * @param freq: frequency in a range of [-1..1], where 1 is a Nyquist frequency
+ * @param phase: phase in range of [-1..1] where 1 is related to 2Pi and -1 is related to -2Pi
+ * @param amplitude: amplitude of the tone, [-1..1) for S16_FIXED output
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_tone_set(nco_bank_t *nco, int32_t index, float freq, float phase, float amplitude);
+
+/**
+ * @brief Change frequency of one tone keeping the phase continuous
+ *
+ * @param nco: pointer to the NCO bank structure
+ * @param index: tone index
+ * @param freq: frequency in a range of [-1..1], where 1 is a Nyquist frequency
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_freq_set(nco_bank_t *nco, int32_t index, float freq);
+
+/**@{*/
+/**
+ * @brief Generate the sum of all tones
+ *
+ * output[i] = sum(amplitude[t] * sin(phase[t] + i * 2Pi * freq[t] / 2)); i=[0..len)
+ * The _cplx version writes the complex tones (cos, sin pairs), 2*len values.
+ * S16_FIXED output saturates, keep the sum of amplitudes below 1 to avoid it.
+ * Phases are updated, the next call continues the signal.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param nco: pointer to the NCO bank structure
+ * @param output: output array, int16_t or float depending on d_type
+ * @param len: amount of samples
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_exec(nco_bank_t *nco, void *output, int32_t len);
+esp_err_t dsps_nco_exec_cplx(nco_bank_t *nco, void *output, int32_t len);
+/**@}*/
+
+/**
+ * @brief Free the memory allocated by dsps_nco_init(...)
+ *
+ * @param nco: pointer to the NCO bank structure
+ */
+void dsps_nco_free(nco_bank_t *nco);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_nco_H_
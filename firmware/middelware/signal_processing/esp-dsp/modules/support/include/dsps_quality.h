@@ -0,0 +1,110 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_quality_H_
+#define _dsps_quality_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_QUALITY_MAX_HARMONICS  10
+
+/**
+ * @brief Spectral quality of one frame or of an average of frames
+ *
+ * Powers are sums of spectrum bins, relative to the input spectrum scale.
+ */
+typedef struct dsps_quality_s {
+    int fundamental_bin;    /*!< Bin of the fundamental tone */
+    float signal;           /*!< Power of the fundamental tone */
+    float distortion;       /*!< Power of the harmonics */
+    float noise;            /*!< Power of everything else except DC */
+    float spur;             /*!< Largest bin outside the fundamental tone (harmonic or not) */
+    float peak;             /*!< Largest bin of the fundamental tone */
+    float snr;              /*!< Signal to noise ratio, dB */
+    float sfdr;             /*!< Spurious free dynamic range, dBc */
+    float thd;              /*!< Total harmonic distortion, dBc (negative value) */
+    float sinad;            /*!< Signal to noise and distortion ratio, dB */
+    float enob;             /*!< Effective number of bits */
+} dsps_quality_t;
+
+/**
+ * @brief Running average of spectral quality
+ */
+typedef struct dsps_quality_avg_s {
+    float alpha;            /*!< Exponential averaging factor, 0 - cumulative mean over all frames */
+    int frames;             /*!< Amount of averaged frames */
+    dsps_quality_t result;  /*!< Averaged powers and metrics calculated from them */
+} dsps_quality_avg_t;
+
+/**@{*/
+/**
+ * @brief   Spectral quality of a sine tone from a computed spectrum
+ *
+ * The function works on an already calculated one sided spectrum (bins 0..N/2-1 of an N points FFT),
+ * so the same FFT could be used for display and analysis.
+ * The fundamental is the largest bin outside DC. The tone, every harmonic and DC occupy
+ * wind_width bins on each side of their center, harmonics above N/2 are folded back.
+ * Noise is the power of all other bins, extended over the whole band by its average. The metrics are:
+ * SNR = signal/noise, SINAD = signal/(noise + distortion), THD = distortion/signal,
+ * SFDR = peak/spur, ENOB = (SINAD - 1.76)/6.02.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: power spectrum (_pow) or magnitude spectrum (_mag)
+ * @param len: amount of bins in the spectrum
+ * @param wind_width: half width of the tone in bins, depends on the window (for example 3 for Hann)
+ * @param harmonics: highest harmonic included in THD, 2..DSPS_QUALITY_MAX_HARMONICS (1 - no harmonics)
+ * @param[out] result: powers and metrics of the spectrum
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_quality_pow_f32(const float *input, int len, int wind_width, int harmonics, dsps_quality_t *result);
+esp_err_t dsps_quality_mag_f32(const float *input, int len, int wind_width, int harmonics, dsps_quality_t *result);
+/**@}*/
+
+/**
+ * @brief   Initialize running average of spectral quality
+ *
+ * @param avg: running average
+ * @param alpha: weight of a new frame (0..1), 0 - cumulative mean over all frames
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_quality_avg_init(dsps_quality_avg_t *avg, float alpha);
+
+/**
+ * @brief   Add one frame to the running average
+ *
+ * Powers are averaged, the metrics in avg->result are recalculated from the averaged powers.
+ *
+ * @param avg: running average
+ * @param[in] frame: result of dsps_quality_pow_f32/dsps_quality_mag_f32
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_quality_avg_update(dsps_quality_avg_t *avg, const dsps_quality_t *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_quality_H_
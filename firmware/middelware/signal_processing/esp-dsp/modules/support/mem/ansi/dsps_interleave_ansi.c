@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_mem.h"
+
+esp_err_t dsps_copy_f32_ansi(const float *input, float *output, int len, int step_in, int step_out)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((step_in == 1) && (step_out == 1)) {
+        dsps_memcpy_ansi(output, input, len * sizeof(float));
+        return ESP_OK;
+    }
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        output[0] = input[0];
+        output[step_out] = input[step_in];
+        output[2 * step_out] = input[2 * step_in];
+        output[3 * step_out] = input[3 * step_in];
+        input += 4 * step_in;
+        output += 4 * step_out;
+    }
+    for (; i < len; i++) {
+        *output = *input;
+        input += step_in;
+        output += step_out;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_copy_s16_ansi(const int16_t *input, int16_t *output, int len, int step_in, int step_out)
+{
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((step_in == 1) && (step_out == 1)) {
+        dsps_memcpy_ansi(output, input, len * sizeof(int16_t));
+        return ESP_OK;
+    }
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        output[0] = input[0];
+        output[step_out] = input[step_in];
+        output[2 * step_out] = input[2 * step_in];
+        output[3 * step_out] = input[3 * step_in];
+        input += 4 * step_in;
+        output += 4 * step_out;
+    }
+    for (; i < len; i++) {
+        *output = *input;
+        input += step_in;
+        output += step_out;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_interleave_f32_ansi(const float *const *input, float *output, int len, int channels)
+{
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (channels < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // Stereo and complex data in one pass
+    if ((channels == 2) && (input[0] != NULL) && (input[1] != NULL)) {
+        const float *in0 = input[0];
+        const float *in1 = input[1];
+        for (int i = 0; i < len; i++) {
+            output[2 * i + 0] = in0[i];
+            output[2 * i + 1] = in1[i];
+        }
+        return ESP_OK;
+    }
+    for (int c = 0; c < channels; c++) {
+        if (input[c] != NULL) {
+            dsps_copy_f32_ansi(input[c], &output[c], len, 1, channels);
+        } else {
+            float *out = &output[c];
+            for (int i = 0; i < len; i++) {
+                out[i * channels] = 0;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_interleave_s16_ansi(const int16_t *const *input, int16_t *output, int len, int channels)
+{
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (channels < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((channels == 2) && (input[0] != NULL) && (input[1] != NULL)) {
+        const int16_t *in0 = input[0];
+        const int16_t *in1 = input[1];
+        for (int i = 0; i < len; i++) {
+            output[2 * i + 0] = in0[i];
+            output[2 * i + 1] = in1[i];
+        }
+        return ESP_OK;
+    }
+    for (int c = 0; c < channels; c++) {
+        if (input[c] != NULL) {
+            dsps_copy_s16_ansi(input[c], &output[c], len, 1, channels);
+        } else {
+            int16_t *out = &output[c];
+            for (int i = 0; i < len; i++) {
+                out[i * channels] = 0;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_deinterleave_f32_ansi(const float *input, float *const *output, int len, int channels)
+{
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (channels < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((channels == 2) && (output[0] != NULL) && (output[1] != NULL)) {
+        float *out0 = output[0];
+        float *out1 = output[1];
+        for (int i = 0; i < len; i++) {
+            out0[i] = input[2 * i + 0];
+            out1[i] = input[2 * i + 1];
+        }
+        return ESP_OK;
+    }
+    for (int c = 0; c < channels; c++) {
+        if (output[c] != NULL) {
+            dsps_copy_f32_ansi(&input[c], output[c], len, channels, 1);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_deinterleave_s16_ansi(const int16_t *input, int16_t *const *output, int len, int channels)
+{
+    if ((NULL == input) || (NULL == output)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (channels < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((channels == 2) && (output[0] != NULL) && (output[1] != NULL)) {
+        int16_t *out0 = output[0];
+        int16_t *out1 = output[1];
+        for (int i = 0; i < len; i++) {
+            out0[i] = input[2 * i + 0];
+            out1[i] = input[2 * i + 1];
+        }
+        return ESP_OK;
+    }
+    for (int c = 0; c < channels; c++) {
+        if (output[c] != NULL) {
+            dsps_copy_s16_ansi(&input[c], output[c], len, channels, 1);
+        }
+    }
+    return ESP_OK;
+}
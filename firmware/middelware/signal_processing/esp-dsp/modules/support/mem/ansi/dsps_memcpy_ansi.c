@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include "dsps_mem.h"
+
+// Shorter copies do not pay off the word alignment
+#define MEM_WORD_MIN_LEN    16
+
+void *dsps_memcpy_ansi(void *arr_dest, const void *arr_src, size_t arr_len)
+{
+    uint8_t *dst = (uint8_t *)arr_dest;
+    const uint8_t *src = (const uint8_t *)arr_src;
+
+    if (arr_len >= MEM_WORD_MIN_LEN) {
+        while ((uintptr_t)dst & 3) {
+            *dst++ = *src++;
+            arr_len--;
+        }
+        uint32_t *d = (uint32_t *)dst;
+        size_t words = arr_len >> 2;
+        int src_offset = (uintptr_t)src & 3;
+        if (src_offset == 0) {
+            const uint32_t *s = (const uint32_t *)src;
+            for (; words >= 4; words -= 4) {
+                d[0] = s[0];
+                d[1] = s[1];
+                d[2] = s[2];
+                d[3] = s[3];
+                d += 4;
+                s += 4;
+            }
+            while (words--) {
+                *d++ = *s++;
+            }
+        } else {
+            // Source is read by aligned words and two neighbours are merged (little endian).
+            // The last read word always holds at least one requested byte.
+            const uint32_t *s = (const uint32_t *)(src - src_offset);
+            int shift_r = src_offset * 8;
+            int shift_l = 32 - shift_r;
+            uint32_t w0 = *s++;
+            while (words--) {
+                uint32_t w1 = *s++;
+                *d++ = (w0 >> shift_r) | (w1 << shift_l);
+                w0 = w1;
+            }
+        }
+        size_t copied = (uint8_t *)d - dst;
+        dst += copied;
+        src += copied;
+        arr_len -= copied;
+    }
+    while (arr_len--) {
+        *dst++ = *src++;
+    }
+    return arr_dest;
+}
+
+void *dsps_memset_ansi(void *arr_dest, uint8_t set_val, size_t set_size)
+{
+    uint8_t *dst = (uint8_t *)arr_dest;
+
+    if (set_size >= MEM_WORD_MIN_LEN) {
+        while ((uintptr_t)dst & 3) {
+            *dst++ = set_val;
+            set_size--;
+        }
+        uint32_t value = set_val * 0x01010101UL;
+        uint32_t *d = (uint32_t *)dst;
+        size_t words = set_size >> 2;
+        for (; words >= 4; words -= 4) {
+            d[0] = value;
+            d[1] = value;
+            d[2] = value;
+            d[3] = value;
+            d += 4;
+        }
+        while (words--) {
+            *d++ = value;
+        }
+        set_size &= 3;
+        dst = (uint8_t *)d;
+    }
+    while (set_size--) {
+        *dst++ = set_val;
+    }
+    return arr_dest;
+}
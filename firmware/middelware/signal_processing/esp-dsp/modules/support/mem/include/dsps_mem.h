@@ -43,6 +43,103 @@ void *dsps_memcpy_aes3(void *arr_dest, const void *arr_src, size_t arr_len);
  * @return: pointer to dest array
  */
 void *dsps_memset_aes3(void *arr_dest, uint8_t set_val, size_t set_size);
+/**@}*/
+
+/**@{*/
+/**
+ *  @brief memory copy function with word wide access
+ *
+ * Head and tail are copied byte by byte, the body with 32-bit words.
+ * When source and destination have different alignment, the source is read
+ * by aligned words and shifted into place.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param arr_dest: pointer to the destination array
+ * @param arr_src: pointer to the source array
+ * @param arr_len: count of bytes to be copied from arr_src to arr_dest
+ *
+ * @return: pointer to dest array
+ */
+void *dsps_memcpy_ansi(void *arr_dest, const void *arr_src, size_t arr_len);
+
+/**
+ *  @brief memory set function with word wide access
+ *
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param arr_dest: pointer to the destination array
+ * @param set_val: byte value, the dest array will be set with
+ * @param set_size: count of bytes, the dest array will be set with
+ *
+ * @return: pointer to dest array
+ */
+void *dsps_memset_ansi(void *arr_dest, uint8_t set_val, size_t set_size);
+/**@}*/
+
+/**@{*/
+/**
+ *  @brief strided copy of array
+ *
+ * output[i*step_out] = input[i*step_in]; i=[0..len)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array, must not overlap the input
+ * @param len: amount of elements to copy
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_copy_f32_ansi(const float *input, float *output, int len, int step_in, int step_out);
+esp_err_t dsps_copy_s16_ansi(const int16_t *input, int16_t *output, int len, int step_in, int step_out);
+/**@}*/
+
+/**@{*/
+/**
+ *  @brief interleave planar channels into one array
+ *
+ * output[i*channels + c] = input[c][i]; i=[0..len), c=[0..channels)
+ * A NULL channel pointer writes zeros, so a real signal becomes a complex one with
+ * input = {real, NULL} and channels = 2.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: array of channels pointers
+ * @param output: interleaved output array, channels*len elements
+ * @param len: amount of elements per channel
+ * @param channels: amount of channels
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_interleave_f32_ansi(const float *const *input, float *output, int len, int channels);
+esp_err_t dsps_interleave_s16_ansi(const int16_t *const *input, int16_t *output, int len, int channels);
+/**@}*/
+
+/**@{*/
+/**
+ *  @brief deinterleave one array into planar channels
+ *
+ * output[c][i] = input[i*channels + c]; i=[0..len), c=[0..channels)
+ * A NULL channel pointer skips the channel, so the real part of a complex signal is
+ * extracted with output = {real, NULL} and channels = 2.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: interleaved input array, channels*len elements
+ * @param output: array of channels pointers
+ * @param len: amount of elements per channel
+ * @param channels: amount of channels
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_deinterleave_f32_ansi(const float *input, float *const *output, int len, int channels);
+esp_err_t dsps_deinterleave_s16_ansi(const int16_t *input, int16_t *const *output, int len, int channels);
+/**@}*/
 
 #ifdef __cplusplus
 }
@@ -54,14 +151,21 @@ void *dsps_memset_aes3(void *arr_dest, uint8_t set_val, size_t set_size);
 #define dsps_memcpy dsps_memcpy_aes3
 #define dsps_memset dsps_memset_aes3
 #else
-#define dsps_memcpy memcpy
-#define dsps_memset memset
+#define dsps_memcpy dsps_memcpy_ansi
+#define dsps_memset dsps_memset_ansi
 #endif
 
 #else // CONFIG_DSP_OPTIMIZED
 
-#define dsps_memcpy memcpy
-#define dsps_memset memset
+#define dsps_memcpy dsps_memcpy_ansi
+#define dsps_memset dsps_memset_ansi
 
 #endif // CONFIG_DSP_OPTIMIZED
+
+#define dsps_copy_f32 dsps_copy_f32_ansi
+#define dsps_copy_s16 dsps_copy_s16_ansi
+#define dsps_interleave_f32 dsps_interleave_f32_ansi
+#define dsps_interleave_s16 dsps_interleave_s16_ansi
+#define dsps_deinterleave_f32 dsps_deinterleave_f32_ansi
+#define dsps_deinterleave_s16 dsps_deinterleave_s16_ansi
 #endif // _dsps_mem_H_
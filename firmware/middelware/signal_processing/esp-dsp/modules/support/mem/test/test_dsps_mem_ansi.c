@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <malloc.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+
+#include "dsps_mem.h"
+#include "dsp_tests.h"
+
+#define MEM_TEST_LEN        256
+#define MEM_BENCH_LEN       1024
+#define MEM_REPEAT_COUNT    100
+
+static const char *TAG = "dsps_mem_ansi";
+
+/*
+Test memcpy and memset against the libc reference for every combination of
+source/destination misalignment (0..3 bytes) and lengths 0..MEM_TEST_LEN,
+with canary bytes on both sides of the destination.
+*/
+TEST_CASE("dsps_memcpy_memset_ansi functionality", "[dsps]")
+{
+    const int canary = 8;
+    uint8_t *src = (uint8_t *)memalign(16, MEM_TEST_LEN + 16);
+    uint8_t *dest = (uint8_t *)memalign(16, MEM_TEST_LEN + 16 + 2 * canary);
+    uint8_t *ref = (uint8_t *)memalign(16, MEM_TEST_LEN + 16 + 2 * canary);
+
+    for (int i = 0; i < MEM_TEST_LEN + 16; i++) {
+        src[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (int src_off = 0; src_off < 4; src_off++) {
+        for (int dest_off = 0; dest_off < 4; dest_off++) {
+            for (int len = 0; len <= MEM_TEST_LEN; len++) {
+                memset(dest, 0x55, MEM_TEST_LEN + 16 + 2 * canary);
+                memset(ref, 0x55, MEM_TEST_LEN + 16 + 2 * canary);
+                void *ret = dsps_memcpy_ansi(&dest[canary + dest_off], &src[src_off], len);
+                memcpy(&ref[canary + dest_off], &src[src_off], len);
+                TEST_ASSERT_EQUAL_PTR(&dest[canary + dest_off], ret);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, dest, MEM_TEST_LEN + 16 + 2 * canary);
+            }
+        }
+    }
+    for (int dest_off = 0; dest_off < 4; dest_off++) {
+        for (int len = 0; len <= MEM_TEST_LEN; len++) {
+            memset(dest, 0x55, MEM_TEST_LEN + 16 + 2 * canary);
+            memset(ref, 0x55, MEM_TEST_LEN + 16 + 2 * canary);
+            void *ret = dsps_memset_ansi(&dest[canary + dest_off], 0xa3, len);
+            memset(&ref[canary + dest_off], 0xa3, len);
+            TEST_ASSERT_EQUAL_PTR(&dest[canary + dest_off], ret);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, dest, MEM_TEST_LEN + 16 + 2 * canary);
+        }
+    }
+
+    free(src);
+    free(dest);
+    free(ref);
+}
+
+TEST_CASE("dsps_copy_f32_ansi functionality", "[dsps]")
+{
+    float input[MEM_TEST_LEN];
+    float output[MEM_TEST_LEN];
+    int16_t input_s16[MEM_TEST_LEN];
+    int16_t output_s16[MEM_TEST_LEN];
+
+    for (int i = 0; i < MEM_TEST_LEN; i++) {
+        input[i] = i;
+        input_s16[i] = i;
+    }
+    for (int step_in = 1; step_in <= 3; step_in++) {
+        for (int step_out = 1; step_out <= 3; step_out++) {
+            int len = MEM_TEST_LEN / 3 - 1;
+            for (int i = 0; i < MEM_TEST_LEN; i++) {
+                output[i] = -1;
+                output_s16[i] = -1;
+            }
+            TEST_ESP_OK(dsps_copy_f32_ansi(input, output, len, step_in, step_out));
+            TEST_ESP_OK(dsps_copy_s16_ansi(input_s16, output_s16, len, step_in, step_out));
+            for (int i = 0; i < MEM_TEST_LEN; i++) {
+                float expected = -1;
+                if (((i % step_out) == 0) && ((i / step_out) < len)) {
+                    expected = input[(i / step_out) * step_in];
+                }
+                TEST_ASSERT_EQUAL(expected, output[i]);
+                TEST_ASSERT_EQUAL((int16_t)expected, output_s16[i]);
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_copy_f32_ansi(NULL, output, 1, 1, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_copy_f32_ansi(input, output, -1, 1, 1));
+}
+
+TEST_CASE("dsps_interleave_f32_ansi functionality", "[dsps]")
+{
+    const int len = 37;
+    float planar[4][37];
+    float interleaved[4 * 37];
+    float restored[4][37];
+    int16_t planar_s16[4][37];
+    int16_t interleaved_s16[4 * 37];
+    int16_t restored_s16[4][37];
+
+    for (int c = 0; c < 4; c++) {
+        for (int i = 0; i < len; i++) {
+            planar[c][i] = c * 1000 + i;
+            planar_s16[c][i] = c * 1000 + i;
+        }
+    }
+    for (int channels = 1; channels <= 4; channels++) {
+        const float *in[4] = {planar[0], planar[1], planar[2], planar[3]};
+        float *out[4] = {restored[0], restored[1], restored[2], restored[3]};
+        const int16_t *in_s16[4] = {planar_s16[0], planar_s16[1], planar_s16[2], planar_s16[3]};
+        int16_t *out_s16[4] = {restored_s16[0], restored_s16[1], restored_s16[2], restored_s16[3]};
+        memset(restored, 0, sizeof(restored));
+        memset(restored_s16, 0, sizeof(restored_s16));
+
+        TEST_ESP_OK(dsps_interleave_f32_ansi(in, interleaved, len, channels));
+        TEST_ESP_OK(dsps_interleave_s16_ansi(in_s16, interleaved_s16, len, channels));
+        for (int i = 0; i < len * channels; i++) {
+            TEST_ASSERT_EQUAL(planar[i % channels][i / channels], interleaved[i]);
+            TEST_ASSERT_EQUAL(planar_s16[i % channels][i / channels], interleaved_s16[i]);
+        }
+        TEST_ESP_OK(dsps_deinterleave_f32_ansi(interleaved, out, len, channels));
+        TEST_ESP_OK(dsps_deinterleave_s16_ansi(interleaved_s16, out_s16, len, channels));
+        for (int c = 0; c < channels; c++) {
+            TEST_ASSERT_EQUAL(0, memcmp(planar[c], restored[c], len * sizeof(float)));
+            TEST_ASSERT_EQUAL(0, memcmp(planar_s16[c], restored_s16[c], len * sizeof(int16_t)));
+        }
+    }
+
+    // Real to complex and back
+    const float *real_in[2] = {planar[1], NULL};
+    TEST_ESP_OK(dsps_interleave_f32_ansi(real_in, interleaved, len, 2));
+    for (int i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL(planar[1][i], interleaved[2 * i]);
+        TEST_ASSERT_EQUAL(0, interleaved[2 * i + 1]);
+    }
+    float *real_out[2] = {restored[0], NULL};
+    memset(restored, 0, sizeof(restored));
+    TEST_ESP_OK(dsps_deinterleave_f32_ansi(interleaved, real_out, len, 2));
+    TEST_ASSERT_EQUAL(0, memcmp(planar[1], restored[0], len * sizeof(float)));
+    TEST_ASSERT_EQUAL(0, restored[1][0]);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_interleave_f32_ansi(real_in, interleaved, len, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_deinterleave_f32_ansi(NULL, real_out, len, 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_interleave_f32_ansi(real_in, interleaved, -1, 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_deinterleave_f32_ansi(interleaved, real_out, -1, 2));
+}
+
+TEST_CASE("dsps_memcpy_memset_ansi benchmark", "[dsps]")
+{
+    uint8_t *src = (uint8_t *)memalign(16, MEM_BENCH_LEN + 4);
+    uint8_t *dest = (uint8_t *)memalign(16, MEM_BENCH_LEN + 4);
+    memset(src, 0x11, MEM_BENCH_LEN + 4);
+
+    for (int src_off = 0; src_off < 2; src_off++) {
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < MEM_REPEAT_COUNT; i++) {
+            dsps_memcpy_ansi(dest, &src[src_off], MEM_BENCH_LEN);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        float cycles_dsp = (float)(end_b - start_b) / MEM_REPEAT_COUNT;
+
+        start_b = xthal_get_ccount();
+        for (int i = 0; i < MEM_REPEAT_COUNT; i++) {
+            memcpy(dest, &src[src_off], MEM_BENCH_LEN);
+        }
+        end_b = xthal_get_ccount();
+        float cycles_libc = (float)(end_b - start_b) / MEM_REPEAT_COUNT;
+        ESP_LOGI(TAG, "memcpy %i bytes, source offset %i: dsps_memcpy_ansi %.0f cycles, memcpy %.0f cycles",
+                 MEM_BENCH_LEN, src_off, cycles_dsp, cycles_libc);
+    }
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0; i < MEM_REPEAT_COUNT; i++) {
+        dsps_memset_ansi(dest, 0x22, MEM_BENCH_LEN);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_dsp = (float)(end_b - start_b) / MEM_REPEAT_COUNT;
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < MEM_REPEAT_COUNT; i++) {
+        memset(dest, 0x22, MEM_BENCH_LEN);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_libc = (float)(end_b - start_b) / MEM_REPEAT_COUNT;
+    ESP_LOGI(TAG, "memset %i bytes: dsps_memset_ansi %.0f cycles, memset %.0f cycles", MEM_BENCH_LEN, cycles_dsp, cycles_libc);
+
+    free(src);
+    free(dest);
+}
@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_nco.h"
+#include "dsp_common.h"
+#include "esp_log.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+#define Q15_MAX INT16_MAX
+#define NCO_QUARTER_PHASE   0x40000000UL
+
+static const char *TAG = "dsps_nco";
+
+static inline float nco_sample_f32(const float *lut, uint32_t mask, int32_t shift, uint32_t phase)
+{
+    uint32_t idx = phase >> shift;
+    // 24 bits of the phase below the LUT index interpolate between two entries
+    float frac = (float)((phase << (32 - shift)) >> 8) * (1.0f / 16777216.0f);
+    float a = lut[idx];
+    float b = lut[(idx + 1) & mask];
+    return a + (b - a) * frac;
+}
+
+static inline int32_t nco_sample_s16(const int16_t *lut, uint32_t mask, int32_t shift, uint32_t phase)
+{
+    uint32_t idx = phase >> shift;
+    int32_t frac = (int32_t)((phase << (32 - shift)) >> 17);
+    int32_t a = lut[idx];
+    int32_t b = lut[(idx + 1) & mask];
+    return a + (((b - a) * frac) >> 15);
+}
+
+static inline int16_t nco_sat_s16(int32_t value)
+{
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+static esp_err_t nco_check_tone(nco_bank_t *nco, int32_t index, float freq)
+{
+    if ((nco == NULL) || (nco->tone == NULL)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((index < 0) || (index >= nco->tones)) {
+        ESP_LOGE(TAG, "The tone index is out of range.");
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    // frequency is a Nyquist frequency, must be in a range from (-1 to 1)
+    if ((freq >= 1) || (freq <= -1)) {
+        ESP_LOGE(TAG, "The frequency is out of range. Valid range is +/- 1. ");
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_init(nco_bank_t *nco, out_d_type d_type, void *lut, int32_t lut_len, int32_t tones)
+{
+    nco->lut = lut;
+    nco->lut_len = lut_len;
+    nco->tone = NULL;
+    nco->tones = tones;
+    nco->d_type = d_type;
+    nco->free_status = 0;
+
+    // length of the LUT must be power of 2
+    if (!dsp_is_power_of_two(lut_len) || (lut_len < 2)) {
+        ESP_LOGE(TAG, "The length of the LUT must be power of 2");
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((lut == NULL) && ((lut_len > 8192) || (lut_len < 256))) {
+        ESP_LOGE(TAG, "The length of the LUT table out of range. Valid range is 256 to 8192");
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((d_type != S16_FIXED) && (d_type != F32_FLOAT)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (tones < 1) {
+        ESP_LOGE(TAG, "At least one tone is required");
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    nco->lut_shift = 32 - dsp_power_of_two(lut_len);
+
+    nco->tone = (nco_tone_t *)calloc(tones, sizeof(nco_tone_t));
+    if (nco->tone == NULL) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    nco->free_status |= 0x0002;
+
+    // LUT table coefficients generation, same table as dsps_cplx_gen
+    if (lut == NULL) {
+        if (d_type == S16_FIXED) {
+            int16_t *local_lut = (int16_t *)malloc(lut_len * sizeof(int16_t));
+            if (local_lut == NULL) {
+                dsps_nco_free(nco);
+                return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+            }
+            for (int i = 0 ; i < lut_len; i++) {
+                local_lut[i] = (int16_t)(sin((2.0 * M_PI) * ((double)i / lut_len)) * Q15_MAX);
+            }
+            nco->lut = (void *)local_lut;
+        } else {
+            float *local_lut = (float *)malloc(lut_len * sizeof(float));
+            if (local_lut == NULL) {
+                dsps_nco_free(nco);
+                return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+            }
+            for (int i = 0 ; i < lut_len; i++) {
+                local_lut[i] = (float)sin((2.0 * M_PI) * ((double)i / lut_len));
+            }
+            nco->lut = (void *)local_lut;
+        }
+        nco->free_status |= 0x0001;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_tone_set(nco_bank_t *nco, int32_t index, float freq, float phase, float amplitude)
+{
+    esp_err_t ret = nco_check_tone(nco, index, freq);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // phase in a range from (-1 to 1)
+    if ((phase >= 1) || (phase <= -1)) {
+        ESP_LOGE(TAG, "The phase is out of range. Valid range is +/- 1. ");
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((nco->d_type == S16_FIXED) && ((amplitude >= 1) || (amplitude < -1))) {
+        ESP_LOGE(TAG, "The amplitude is out of Q15 range.");
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    nco_tone_t *tone = &nco->tone[index];
+    tone->phase = (uint32_t)(int64_t)(phase * 4294967296.0);
+    tone->phase_inc = (uint32_t)(int32_t)(freq * 2147483648.0);
+    tone->amplitude = amplitude;
+    tone->amplitude_q15 = (int16_t)(amplitude * 32768.0f);
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_freq_set(nco_bank_t *nco, int32_t index, float freq)
+{
+    esp_err_t ret = nco_check_tone(nco, index, freq);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    nco->tone[index].phase_inc = (uint32_t)(int32_t)(freq * 2147483648.0);
+    return ESP_OK;
+}
+
+static esp_err_t dsps_nco_exec_(nco_bank_t *nco, void *output, int32_t len, int cplx)
+{
+    if ((nco == NULL) || (nco->tone == NULL)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (output == NULL) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    uint32_t mask = nco->lut_len - 1;
+    int32_t shift = nco->lut_shift;
+    int step = cplx ? 2 : 1;
+
+    // Tone by tone keeps the phase and increment in registers, the first tone initializes the output
+    for (int t = 0; t < nco->tones; t++) {
+        nco_tone_t *tone = &nco->tone[t];
+        uint32_t phase = tone->phase;
+        uint32_t inc = tone->phase_inc;
+        if (nco->d_type == F32_FLOAT) {
+            const float *lut = (const float *)nco->lut;
+            float *out = (float *)output;
+            float amp = tone->amplitude;
+            for (int i = 0; i < len; i++) {
+                float value = amp * nco_sample_f32(lut, mask, shift, phase);
+                if (cplx) {
+                    float re = amp * nco_sample_f32(lut, mask, shift, phase + NCO_QUARTER_PHASE);
+                    out[i * 2] = (t == 0) ? re : out[i * 2] + re;
+                }
+                out[i * step + cplx] = (t == 0) ? value : out[i * step + cplx] + value;
+                phase += inc;
+            }
+        } else {
+            const int16_t *lut = (const int16_t *)nco->lut;
+            int16_t *out = (int16_t *)output;
+            int32_t amp = tone->amplitude_q15;
+            for (int i = 0; i < len; i++) {
+                int32_t value = (amp * nco_sample_s16(lut, mask, shift, phase) + 0x4000) >> 15;
+                if (cplx) {
+                    int32_t re = (amp * nco_sample_s16(lut, mask, shift, phase + NCO_QUARTER_PHASE) + 0x4000) >> 15;
+                    out[i * 2] = nco_sat_s16((t == 0) ? re : out[i * 2] + re);
+                }
+                out[i * step + cplx] = nco_sat_s16((t == 0) ? value : out[i * step + cplx] + value);
+                phase += inc;
+            }
+        }
+        tone->phase = phase;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_exec(nco_bank_t *nco, void *output, int32_t len)
+{
+    return dsps_nco_exec_(nco, output, len, 0);
+}
+
+esp_err_t dsps_nco_exec_cplx(nco_bank_t *nco, void *output, int32_t len)
+{
+    return dsps_nco_exec_(nco, output, len, 1);
+}
+
+void dsps_nco_free(nco_bank_t *nco)
+{
+    if (nco->free_status & 0x0001) {
+        free(nco->lut);
+        nco->lut = NULL;
+    }
+    if (nco->free_status & 0x0002) {
+        free(nco->tone);
+        nco->tone = NULL;
+    }
+    nco->free_status = 0;
+}
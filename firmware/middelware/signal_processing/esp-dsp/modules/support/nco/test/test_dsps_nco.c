@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+
+#include "dsps_nco.h"
+#include "dsp_tests.h"
+
+#define NCO_LEN     256
+#define NCO_TONES   4
+
+static const char *TAG = "dsps_nco";
+
+static const float test_freq[NCO_TONES] = {0.01f, -0.123f, 0.5f, 0.87f};
+static const float test_phase[NCO_TONES] = {0, 0.25f, -0.5f, 0.9f};
+static const float test_amp[NCO_TONES] = {0.4f, 0.2f, 0.15f, 0.1f};
+
+static double nco_reference(int i, int cplx)
+{
+    double sum = 0;
+    for (int t = 0; t < NCO_TONES; t++) {
+        double arg = 2 * M_PI * (test_phase[t] + 0.5 * test_freq[t] * i);
+        sum += test_amp[t] * (cplx ? cos(arg) : sin(arg));
+    }
+    return sum;
+}
+
+TEST_CASE("dsps_nco functionality", "[dsps]")
+{
+    float out_f32[NCO_LEN * 2];
+    int16_t out_s16[NCO_LEN * 2];
+    const out_d_type types[2] = {F32_FLOAT, S16_FIXED};
+
+    for (int type = 0; type < 2; type++) {
+        for (int cplx = 0; cplx < 2; cplx++) {
+            nco_bank_t nco;
+            TEST_ESP_OK(dsps_nco_init(&nco, types[type], NULL, 1024, NCO_TONES));
+            for (int t = 0; t < NCO_TONES; t++) {
+                TEST_ESP_OK(dsps_nco_tone_set(&nco, t, test_freq[t], test_phase[t], test_amp[t]));
+            }
+            // Two calls must continue the phase
+            int half = NCO_LEN / 2 + 3;
+            for (int part = 0; part < 2; part++) {
+                int offset = part ? half : 0;
+                int len = part ? NCO_LEN - half : half;
+                int step = cplx ? 2 : 1;
+                if (types[type] == F32_FLOAT) {
+                    TEST_ESP_OK(cplx ? dsps_nco_exec_cplx(&nco, &out_f32[offset * step], len) : dsps_nco_exec(&nco, &out_f32[offset * step], len));
+                } else {
+                    TEST_ESP_OK(cplx ? dsps_nco_exec_cplx(&nco, &out_s16[offset * step], len) : dsps_nco_exec(&nco, &out_s16[offset * step], len));
+                }
+            }
+            double max_err = 0;
+            for (int i = 0; i < NCO_LEN; i++) {
+                for (int part = 0; part <= cplx; part++) {
+                    int pos = cplx ? i * 2 + (1 - part) : i;
+                    double value = (types[type] == F32_FLOAT) ? out_f32[pos] : out_s16[pos] / 32768.0;
+                    double err = fabs(value - nco_reference(i, part));
+                    if (err > max_err) {
+                        max_err = err;
+                    }
+                }
+            }
+            ESP_LOGI(TAG, "%s %s: max error %e", types[type] == F32_FLOAT ? "f32" : "s16", cplx ? "complex" : "real", max_err);
+            if (types[type] == F32_FLOAT) {
+                TEST_ASSERT_MESSAGE(max_err < 2e-5, "Result out of range!");
+            } else {
+                TEST_ASSERT_MESSAGE(max_err < 4.0 / 32768, "Result out of range!");
+            }
+            dsps_nco_free(&nco);
+        }
+    }
+
+    // Frequency change keeps the phase
+    nco_bank_t nco;
+    TEST_ESP_OK(dsps_nco_init(&nco, F32_FLOAT, NULL, 1024, 1));
+    TEST_ESP_OK(dsps_nco_tone_set(&nco, 0, 0.25f, 0, 1));
+    TEST_ESP_OK(dsps_nco_exec(&nco, out_f32, 3));
+    TEST_ESP_OK(dsps_nco_freq_set(&nco, 0, 0.5f));
+    TEST_ESP_OK(dsps_nco_exec(&nco, out_f32, 1));
+    // phase after 3 samples of Pi/4
+    TEST_ASSERT_MESSAGE(fabsf(out_f32[0] - sinf(3 * M_PI / 4)) < 1e-5, "Result out of range!");
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_nco_tone_set(&nco, 1, 0.1f, 0, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_nco_freq_set(&nco, 0, 1.5f));
+    dsps_nco_free(&nco);
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_nco_init(&nco, F32_FLOAT, NULL, 1000, 1));
+}
+
+TEST_CASE("dsps_nco benchmark", "[dsps]")
+{
+    static float out_f32[NCO_LEN];
+    static int16_t out_s16[NCO_LEN];
+    nco_bank_t nco_f32;
+    nco_bank_t nco_s16;
+    TEST_ESP_OK(dsps_nco_init(&nco_f32, F32_FLOAT, NULL, 1024, NCO_TONES));
+    TEST_ESP_OK(dsps_nco_init(&nco_s16, S16_FIXED, NULL, 1024, NCO_TONES));
+    for (int t = 0; t < NCO_TONES; t++) {
+        TEST_ESP_OK(dsps_nco_tone_set(&nco_f32, t, test_freq[t], test_phase[t], test_amp[t]));
+        TEST_ESP_OK(dsps_nco_tone_set(&nco_s16, t, test_freq[t], test_phase[t], test_amp[t]));
+    }
+
+    unsigned int start_b = xthal_get_ccount();
+    dsps_nco_exec(&nco_f32, out_f32, NCO_LEN);
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_f32 = (float)(end_b - start_b) / (NCO_LEN * NCO_TONES);
+
+    start_b = xthal_get_ccount();
+    dsps_nco_exec(&nco_s16, out_s16, NCO_LEN);
+    end_b = xthal_get_ccount();
+    float cycles_s16 = (float)(end_b - start_b) / (NCO_LEN * NCO_TONES);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < NCO_LEN; i++) {
+        float sum = 0;
+        for (int t = 0; t < NCO_TONES; t++) {
+            sum += test_amp[t] * sinf(2 * M_PI * (test_phase[t] + 0.5f * test_freq[t] * i));
+        }
+        out_f32[i] = sum;
+    }
+    end_b = xthal_get_ccount();
+    float cycles_sinf = (float)(end_b - start_b) / (NCO_LEN * NCO_TONES);
+
+    ESP_LOGI(TAG, "cycles per sample and tone: f32 %2.1f, s16 %2.1f, sinf %2.1f", cycles_f32, cycles_s16, cycles_sinf);
+    dsps_nco_free(&nco_f32);
+    dsps_nco_free(&nco_s16);
+}
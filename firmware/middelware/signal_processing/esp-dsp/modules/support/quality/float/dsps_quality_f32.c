@@ -0,0 +1,194 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_quality.h"
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+typedef struct {
+    int lo;
+    int hi;
+} quality_region_t;
+
+static inline float quality_bin(const float *input, int i, int is_mag)
+{
+    float value = input[i];
+    return is_mag ? value * value : value;
+}
+
+static inline int quality_in_regions(const quality_region_t *regions, int count, int lo, int hi)
+{
+    for (int r = 0; r < count; r++) {
+        if ((lo <= regions[r].hi) && (hi >= regions[r].lo)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void quality_metrics(dsps_quality_t *result)
+{
+    float signal = result->signal + FLT_MIN;
+    result->snr = 10 * log10f(signal / (result->noise + FLT_MIN));
+    result->sinad = 10 * log10f(signal / (result->noise + result->distortion + FLT_MIN));
+    result->thd = 10 * log10f((result->distortion + FLT_MIN) / signal);
+    result->sfdr = 10 * log10f((result->peak + FLT_MIN) / (result->spur + FLT_MIN));
+    result->enob = (result->sinad - 1.76f) / 6.02f;
+}
+
+static esp_err_t dsps_quality_f32(const float *input, int len, int wind_width, int harmonics, dsps_quality_t *result, int is_mag)
+{
+    if ((NULL == input) || (NULL == result)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((wind_width < 0) || (len < 4 * wind_width + 4)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((harmonics < 1) || (harmonics > DSPS_QUALITY_MAX_HARMONICS)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+
+    quality_region_t regions[DSPS_QUALITY_MAX_HARMONICS + 1];
+    int count = 0;
+    int first = wind_width + 1;
+    // DC and its leakage are not part of the noise
+    regions[count].lo = 0;
+    regions[count].hi = wind_width;
+    count++;
+
+    int k0 = first;
+    float peak = quality_bin(input, first, is_mag);
+    for (int i = first + 1; i < len; i++) {
+        float value = quality_bin(input, i, is_mag);
+        if (value > peak) {
+            peak = value;
+            k0 = i;
+        }
+    }
+    regions[count].lo = k0 - wind_width < first ? first : k0 - wind_width;
+    regions[count].hi = k0 + wind_width >= len ? len - 1 : k0 + wind_width;
+    count++;
+    float signal = 0;
+    for (int i = regions[1].lo; i <= regions[1].hi; i++) {
+        signal += quality_bin(input, i, is_mag);
+    }
+
+    // Harmonics above Nyquist are aliased back into the spectrum
+    int N = len * 2;
+    float distortion = 0;
+    for (int h = 2; h <= harmonics; h++) {
+        int k = (int)(((long long)h * k0) % N);
+        if (k >= len) {
+            k = N - k;
+        }
+        if (k >= len) {
+            k = len - 1;
+        }
+        // Harmonics of a non coherent tone drift from h*k0, take the largest bin around
+        int lo = k - wind_width < 0 ? 0 : k - wind_width;
+        int hi = k + wind_width >= len ? len - 1 : k + wind_width;
+        int kh = k;
+        for (int i = lo; i <= hi; i++) {
+            if (quality_bin(input, i, is_mag) > quality_bin(input, kh, is_mag)) {
+                kh = i;
+            }
+        }
+        lo = kh - wind_width < 0 ? 0 : kh - wind_width;
+        hi = kh + wind_width >= len ? len - 1 : kh + wind_width;
+        if (quality_in_regions(regions, count, lo, hi)) {
+            continue;
+        }
+        regions[count].lo = lo;
+        regions[count].hi = hi;
+        count++;
+        for (int i = lo; i <= hi; i++) {
+            distortion += quality_bin(input, i, is_mag);
+        }
+    }
+
+    // Noise is summed directly, subtraction from the total power loses precision at high SNR
+    float noise = 0;
+    float spur = 0;
+    int noise_bins = 0;
+    for (int i = first; i < len; i++) {
+        float value = quality_bin(input, i, is_mag);
+        if ((i < regions[1].lo) || (i > regions[1].hi)) {
+            if (value > spur) {
+                spur = value;
+            }
+            if (!quality_in_regions(&regions[2], count - 2, i, i)) {
+                noise += value;
+                noise_bins++;
+            }
+        }
+    }
+    // Bins occupied by DC, the tone and the harmonics carry noise too, extend the average noise floor over them
+    if (noise_bins > 0) {
+        noise = noise * len / noise_bins;
+    }
+
+    result->fundamental_bin = k0;
+    result->signal = signal;
+    result->distortion = distortion;
+    result->noise = noise;
+    result->spur = spur;
+    result->peak = peak;
+    quality_metrics(result);
+    return ESP_OK;
+}
+
+esp_err_t dsps_quality_pow_f32(const float *input, int len, int wind_width, int harmonics, dsps_quality_t *result)
+{
+    return dsps_quality_f32(input, len, wind_width, harmonics, result, 0);
+}
+
+esp_err_t dsps_quality_mag_f32(const float *input, int len, int wind_width, int harmonics, dsps_quality_t *result)
+{
+    return dsps_quality_f32(input, len, wind_width, harmonics, result, 1);
+}
+
+esp_err_t dsps_quality_avg_init(dsps_quality_avg_t *avg, float alpha)
+{
+    if (NULL == avg) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((alpha < 0) || (alpha > 1)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    avg->alpha = alpha;
+    avg->frames = 0;
+    memset(&avg->result, 0, sizeof(avg->result));
+    return ESP_OK;
+}
+
+esp_err_t dsps_quality_avg_update(dsps_quality_avg_t *avg, const dsps_quality_t *frame)
+{
+    if ((NULL == avg) || (NULL == frame)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    avg->frames++;
+    // First frame initializes the exponential average as well
+    float k = 1.0f / avg->frames;
+    if ((avg->alpha > 0) && (k < avg->alpha)) {
+        k = avg->alpha;
+    }
+    dsps_quality_t *r = &avg->result;
+    r->fundamental_bin = frame->fundamental_bin;
+    r->signal += k * (frame->signal - r->signal);
+    r->distortion += k * (frame->distortion - r->distortion);
+    r->noise += k * (frame->noise - r->noise);
+    r->spur += k * (frame->spur - r->spur);
+    r->peak += k * (frame->peak - r->peak);
+    quality_metrics(r);
+    return ESP_OK;
+}
@@ -0,0 +1,152 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "esp_dsp.h"
+#include "dsps_quality.h"
+
+static const char *TAG = "dsps_quality_f32";
+
+#define N_FFT       1024
+#define WIND_WIDTH  5
+
+static float window[N_FFT];
+static float fft_data[N_FFT * 2];
+static float spectrum[N_FFT / 2];
+
+// Power spectrum of a tone with 2nd/3rd harmonics and uniform noise
+static void quality_test_spectrum(float amplitude, float h2, float h3, float noise, float *pow_out)
+{
+    const float freq = 50.3f / N_FFT;
+    for (int i = 0 ; i < N_FFT ; i++) {
+        float x = amplitude * sinf(2 * M_PI * freq * i);
+        x += h2 * sinf(2 * M_PI * 2 * freq * i + 0.3f);
+        x += h3 * sinf(2 * M_PI * 3 * freq * i + 1.1f);
+        x += noise * ((float)rand() / RAND_MAX - 0.5f);
+        fft_data[i * 2 + 0] = x * window[i];
+        fft_data[i * 2 + 1] = 0;
+    }
+    dsps_fft2r_fc32_ansi(fft_data, N_FFT);
+    dsps_bit_rev_fc32_ansi(fft_data, N_FFT);
+    for (int i = 0 ; i < N_FFT / 2 ; i++) {
+        pow_out[i] = fft_data[i * 2 + 0] * fft_data[i * 2 + 0] + fft_data[i * 2 + 1] * fft_data[i * 2 + 1];
+    }
+}
+
+TEST_CASE("dsps_quality_pow_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_FFT));
+    dsps_wind_blackman_harris_f32(window, N_FFT);
+
+    const float amplitude = 1.0f;
+    const float h2 = 0.01f;
+    const float h3 = 0.005f;
+    const float noise = 0.001f;
+    quality_test_spectrum(amplitude, h2, h3, noise, spectrum);
+
+    dsps_quality_t q;
+    TEST_ESP_OK(dsps_quality_pow_f32(spectrum, N_FFT / 2, WIND_WIDTH, 5, &q));
+
+    // Uniform noise of width "noise" has power noise^2/12
+    float snr_exp = 10 * log10f((amplitude * amplitude / 2) / (noise * noise / 12));
+    float thd_exp = 20 * log10f(sqrtf(h2 * h2 + h3 * h3) / amplitude);
+    float sfdr_exp = 20 * log10f(amplitude / h2);
+    float sinad_exp = 10 * log10f((amplitude * amplitude / 2) / (noise * noise / 12 + (h2 * h2 + h3 * h3) / 2));
+    ESP_LOGI(TAG, "bin %i SNR %2.2f (%2.2f) dB, THD %2.2f (%2.2f) dBc, SFDR %2.2f (%2.2f) dBc, SINAD %2.2f (%2.2f) dB, ENOB %2.2f",
+             q.fundamental_bin, q.snr, snr_exp, q.thd, thd_exp, q.sfdr, sfdr_exp, q.sinad, sinad_exp, q.enob);
+
+    TEST_ASSERT_EQUAL(50, q.fundamental_bin);
+    TEST_ASSERT_MESSAGE(fabsf(q.snr - snr_exp) < 1.0f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(q.thd - thd_exp) < 0.5f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(q.sfdr - sfdr_exp) < 1.0f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(q.sinad - sinad_exp) < 0.5f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(q.enob - (q.sinad - 1.76f) / 6.02f) < 0.01f, "Result out of range!");
+
+    // Magnitude spectrum gives the same result
+    dsps_quality_t q_mag;
+    for (int i = 0 ; i < N_FFT / 2 ; i++) {
+        spectrum[i] = sqrtf(spectrum[i]);
+    }
+    TEST_ESP_OK(dsps_quality_mag_f32(spectrum, N_FFT / 2, WIND_WIDTH, 5, &q_mag));
+    TEST_ASSERT_EQUAL(q.fundamental_bin, q_mag.fundamental_bin);
+    TEST_ASSERT_MESSAGE(fabsf(q.snr - q_mag.snr) < 0.01f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(q.thd - q_mag.thd) < 0.01f, "Result out of range!");
+
+    // Without harmonics the distortion is counted as noise (power spectrum input)
+    dsps_quality_t q_nh;
+    for (int i = 0 ; i < N_FFT / 2 ; i++) {
+        spectrum[i] = spectrum[i] * spectrum[i];
+    }
+    TEST_ESP_OK(dsps_quality_pow_f32(spectrum, N_FFT / 2, WIND_WIDTH, 1, &q_nh));
+    ESP_LOGI(TAG, "Without harmonics SNR %2.2f dB (SINAD %2.2f dB)", q_nh.snr, q.sinad);
+    TEST_ASSERT_EQUAL(0, q_nh.distortion);
+    TEST_ASSERT_EQUAL(q.fundamental_bin, q_nh.fundamental_bin);
+    TEST_ASSERT_MESSAGE(fabsf(q_nh.snr - q.sinad) < 0.5f, "Result out of range!");
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_quality_pow_f32(NULL, N_FFT / 2, WIND_WIDTH, 5, &q));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_quality_pow_f32(spectrum, N_FFT / 2, WIND_WIDTH, 0, &q));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_quality_pow_f32(spectrum, 8, WIND_WIDTH, 5, &q));
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_quality_avg functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_FFT));
+    dsps_wind_blackman_harris_f32(window, N_FFT);
+
+    const float noise = 0.003f;
+    float snr_exp = 10 * log10f(0.5f / (noise * noise / 12));
+    dsps_quality_avg_t mean;
+    dsps_quality_avg_t ema;
+    TEST_ESP_OK(dsps_quality_avg_init(&mean, 0));
+    TEST_ESP_OK(dsps_quality_avg_init(&ema, 0.25f));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_quality_avg_init(&ema, 2));
+
+    float worst = 0;
+    for (int f = 0 ; f < 16 ; f++) {
+        dsps_quality_t q;
+        quality_test_spectrum(1.0f, 0, 0, noise, spectrum);
+        TEST_ESP_OK(dsps_quality_pow_f32(spectrum, N_FFT / 2, WIND_WIDTH, 5, &q));
+        TEST_ESP_OK(dsps_quality_avg_update(&mean, &q));
+        TEST_ESP_OK(dsps_quality_avg_update(&ema, &q));
+        if (fabsf(q.snr - snr_exp) > worst) {
+            worst = fabsf(q.snr - snr_exp);
+        }
+        if (f == 0) {
+            TEST_ASSERT_MESSAGE(fabsf(ema.result.snr - q.snr) < 0.001f, "Result out of range!");
+        }
+    }
+    ESP_LOGI(TAG, "SNR expected %2.2f dB, average %2.2f dB, EMA %2.2f dB, worst frame error %2.2f dB",
+             snr_exp, mean.result.snr, ema.result.snr, worst);
+    TEST_ASSERT_EQUAL(16, mean.frames);
+    TEST_ASSERT_MESSAGE(fabsf(mean.result.snr - snr_exp) < 0.5f, "Result out of range!");
+    TEST_ASSERT_MESSAGE(fabsf(ema.result.snr - snr_exp) < 1.0f, "Result out of range!");
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_quality_pow_f32 benchmark", "[dsps]")
+{
+    dsps_quality_t q;
+    for (int i = 0 ; i < N_FFT / 2 ; i++) {
+        spectrum[i] = 1e-6f;
+    }
+    spectrum[100] = 1;
+    unsigned int start_b = xthal_get_ccount();
+    dsps_quality_pow_f32(spectrum, N_FFT / 2, WIND_WIDTH, 5, &q);
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "dsps_quality_pow_f32 - %i cycles for %i bins", end_b - start_b, N_FFT / 2);
+}
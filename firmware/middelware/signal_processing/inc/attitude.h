@@ -0,0 +1,137 @@
+#ifndef ATTITUDE_H_
+#define ATTITUDE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Attitude Attitude estimation
+ */
+
+/** \brief Attitude (orientation) estimation from a 6-axis IMU (accelerometer + gyroscope)
+ *
+ * Raw MPU6050 samples are converted to SI units using the configured full-scale
+ * ranges and fused by one of the available estimators:
+ *
+ * |   Mode              | Description                                      | Relative cost |
+ * |:-------------------:|:-------------------------------------------------|:-------------:|
+ * | ATTITUDE_MAHONY     | Complementary filter with PI gyro correction     | 1x            |
+ * | ATTITUDE_MADGWICK   | Gradient descent orientation filter              | ~1.5x         |
+ * | ATTITUDE_EKF        | esp-dsp 13 states EKF (ekf_imu13states)          | ~100x         |
+ *
+ * The sample source is a function pointer (usually MPU6050_getMotion6), so the
+ * estimator can be fed with recorded IMU traces through AttitudeProcessRaw().
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define ATTITUDE_GRAVITY        9.80665f    /*!< Standard gravity (m/s^2) */
+/*==================[typedef]================================================*/
+typedef enum attitude_mode {
+    ATTITUDE_MAHONY = 0,    /*!< Mahony complementary filter (cheapest) */
+    ATTITUDE_MADGWICK,      /*!< Madgwick gradient descent filter */
+    ATTITUDE_EKF            /*!< 13 states Extended Kalman Filter, estimates gyro bias */
+} attitude_mode_t;
+
+/**
+ * @brief Raw 6-axis sample source, same signature as MPU6050_getMotion6()
+ */
+typedef void (*attitude_read_t)(int16_t *ax, int16_t *ay, int16_t *az, int16_t *gx, int16_t *gy, int16_t *gz);
+
+typedef struct {
+    attitude_mode_t mode;           /*!< Estimator used */
+    uint8_t accel_range;            /*!< Accelerometer full-scale (MPU6050_ACCEL_FS_2 .. MPU6050_ACCEL_FS_16) */
+    uint8_t gyro_range;             /*!< Gyroscope full-scale (MPU6050_GYRO_FS_250 .. MPU6050_GYRO_FS_2000) */
+    float sample_freq;              /*!< Sample frequency (Hz) */
+    float gain;                     /*!< Madgwick beta or Mahony Kp. 0: default value */
+    float ki;                       /*!< Mahony integral gain. 0: no integral feedback */
+    attitude_read_t read_motion6;   /*!< Sample source, may be NULL when only AttitudeProcessRaw() is used */
+} attitude_config_t;
+
+typedef struct {
+    float q[4];         /*!< Attitude quaternion (w, x, y, z) */
+    float roll;         /*!< Rotation around X axis (rad) */
+    float pitch;        /*!< Rotation around Y axis (rad) */
+    float yaw;          /*!< Rotation around Z axis (rad) */
+    float accel[3];     /*!< Last acceleration sample (m/s^2) */
+    float gyro[3];      /*!< Last angular rate sample (rad/s) */
+} attitude_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialize the attitude estimator
+ *
+ * @param config    Estimator configuration
+ * @return true     Estimator initialized
+ * @return false    Invalid configuration or not enough memory
+ */
+bool AttitudeInit(const attitude_config_t *config);
+
+/**
+ * @brief Release the resources used by the estimator
+ */
+void AttitudeDeinit(void);
+
+/**
+ * @brief Reset attitude to identity (sensor Z axis pointing up)
+ */
+void AttitudeReset(void);
+
+/**
+ * @brief Read one sample from the configured source and update the attitude
+ *
+ * @note Must be called at the configured sample frequency
+ *
+ * @return true     Attitude updated
+ * @return false    Estimator not initialized or without sample source
+ */
+bool AttitudeUpdate(void);
+
+/**
+ * @brief Update the attitude with one raw sample (for example from a recorded trace)
+ *
+ * @param accel     Raw accelerometer sample (x, y, z)
+ * @param gyro      Raw gyroscope sample (x, y, z)
+ */
+void AttitudeProcessRaw(const int16_t accel[3], const int16_t gyro[3]);
+
+/**
+ * @brief Convert a raw sample to SI units with the configured full-scale ranges
+ *
+ * @param accel     Raw accelerometer sample (x, y, z)
+ * @param gyro      Raw gyroscope sample (x, y, z)
+ * @param accel_si  Acceleration (m/s^2)
+ * @param gyro_si   Angular rate (rad/s)
+ */
+void AttitudeConvertRaw(const int16_t accel[3], const int16_t gyro[3], float accel_si[3], float gyro_si[3]);
+
+/**
+ * @brief Get the last estimated attitude
+ *
+ * @param attitude  Structure to store quaternion, Euler angles and last sample
+ */
+void AttitudeGet(attitude_t *attitude);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* ATTITUDE_H_ */
+
+/*==================[end of file]============================================*/
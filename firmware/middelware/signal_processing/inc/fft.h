@@ -16,6 +16,9 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 18/10/2026 | Any signal length (mixed radix / Bluestein FFT with plan cache)		|
+ * | 18/10/2026 | Multi-channel FFTMagnitudeBatch()										|
+ * | 18/10/2026 | FFTFreePlans()															|
  * 
  **/
 
@@ -24,7 +27,14 @@
 #include <stdbool.h>
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
+#ifndef FFT_PLAN_CACHE_SIZE
+#define FFT_PLAN_CACHE_SIZE 2       /*!< Number of non power of two lengths with cached FFT plan */
+#endif
 /*==================[typedef]================================================*/
+typedef enum {
+    FFT_CHANNEL_MAJOR = 0,  /*!< Sample n of channel c at signals[c * signal_lenght + n] */
+    FFT_INTERLEAVED,        /*!< Sample n of channel c at signals[n * channels + c] */
+} fft_layout_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -37,10 +47,29 @@
  */
 bool FFTInit(void);
 
+/**
+ * @brief Release the FFT tables and all cached FFT plans
+ */
+void FFTDeinit(void);
+
+/**
+ * @brief Release the cached FFT plans of non power of two lengths
+ * 
+ * The FFT module stays initialized, plans are created again at the next use of each length.
+ */
+void FFTFreePlans(void);
+
 /**
  * @brief Calculates the Fast Fourier Transform of a given signal
  * 
- * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * @note  Lenght of signal array could be any value up to MAX_SIGNAL_LENGHT. Power of two lengths
+ *        use radix-4 FFT, other lengths use a mixed radix (2, 3, 4, 5) or Bluestein FFT plan,
+ *        created at first use and cached for the last FFT_PLAN_CACHE_SIZE lengths.
+ * 
+ * @note  Cached plans are allocated in the heap. A mixed radix plan takes 16 * signal_lenght bytes,
+ *        a Bluestein plan (lengths with factors other than 2, 3 and 5) takes 8 * signal_lenght + 32 * M
+ *        bytes, M being the power of two >= 2 * signal_lenght - 1: about 144 KB for lengths from
+ *        1025 to 2048. Call FFTFreePlans() when the non power of two lengths are no longer used.
  * 
  * @param signal            Array with signal values (of lenght = signal_lenght)
  * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
@@ -48,6 +77,22 @@ bool FFTInit(void);
  */
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Calculates the FFT magnitude of several channels with the same length
+ * 
+ * Window, FFT tables and buffers are shared by all channels (power of two lengths are
+ * transformed in one batch FFT call).
+ * 
+ * @param signals           Array with the signal values of all channels (lenght = signal_lenght * channels)
+ * @param fft               Array of channels pointers to store FFT magnitude values (each of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of each channel signal
+ * @param channels          Number of channels
+ * @param layout            Layout of the signals array
+ * @return true             FFT calculated
+ * @return false            Not enough memory, or FFT failed (e.g. FFTInit() not called)
+ */
+bool FFTMagnitudeBatch(const float * signals, float * fft[], uint16_t signal_lenght, uint8_t channels, fft_layout_t layout);
+
 /**
  * @brief Return the FFT frequency axis vector
  * 
@@ -0,0 +1,93 @@
+#ifndef OVERSAMPLING_H_
+#define OVERSAMPLING_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Oversampling Oversampling
+ */
+
+/** \brief Oversampling and decimation of ADC samples for higher effective resolution
+ *
+ * Raw 12 bit samples (for example the blocks of an ADC continuous frame) go through a
+ * CIC decimator followed by a FIR (esp-dsp dsps_fird_s16) that compensates the CIC droop,
+ * removes the out of band noise and decimates again:
+ *
+ *      raw (fs) -> CIC (R, N stages) -> FIR (D) -> output (fs / (R * D))
+ *
+ * Every 4x of total decimation adds about 1 bit of effective resolution when the input
+ * has some noise (dither), e.g. 16x (R = 8, N = 3, D = 2) adds ~2 bits.
+ *
+ * Output samples are 16 bit, full scale is raw full scale x 16, so output / 16 can be
+ * converted with the ADC calibration as any raw value.
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define OVERSAMPLING_MAX_CH     4       /*!< Max channels processed */
+/*==================[typedef]================================================*/
+typedef struct {
+    uint8_t channels;       /*!< Channels to process (1 to OVERSAMPLING_MAX_CH) */
+    uint8_t cic_decim;      /*!< CIC decimation factor: 2, 4, 8, 16 or 32 */
+    uint8_t cic_order;      /*!< CIC stages (1 to 4) */
+    uint8_t fir_decim;      /*!< FIR decimation factor: 1, 2, 4 or 8 */
+} oversampling_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialize the decimation chain of all the channels
+ *
+ * @param config    Decimation configuration
+ * @return true     Decimation chain initialized
+ * @return false    Invalid configuration
+ */
+bool OversamplingInit(const oversampling_config_t *config);
+
+/**
+ * @brief Release the resources used by the decimation chain
+ */
+void OversamplingDeinit(void);
+
+/**
+ * @brief Clear the filters state of all the channels (for example after a gap in the input)
+ */
+void OversamplingReset(void);
+
+/**
+ * @brief Decimate a block of raw samples of one channel
+ *
+ * Blocks can have any length, the filters state is kept between calls.
+ *
+ * @param channel   Channel (0 to channels - 1), each one keeps its own filters state
+ * @param input     Raw samples (12 bit)
+ * @param output    Decimated samples (16 bit), at least len / (cic_decim * fir_decim) + 1 long.
+ *                  May be the same array as input
+ * @param len       Amount of raw samples
+ * @return uint16_t Amount of decimated samples written to output
+ */
+uint16_t OversamplingProcess(uint8_t channel, const uint16_t *input, uint16_t *output, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* OVERSAMPLING_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,296 @@
+/**
+ * @file attitude.cpp
+ * @brief Attitude estimation from a 6-axis IMU (Mahony, Madgwick or 13 states EKF)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include <new>
+#include "attitude.h"
+#include "ekf_imu13states.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Attitude Module"
+
+#define ACCEL_LSB_FS_2          16384.0f    /*!< LSB/g for +-2 g, halved for every range step */
+#define GYRO_LSB_FS_250         131.0f      /*!< LSB/(deg/s) for +-250 deg/s, halved for every range step */
+#define MAX_RANGE               3
+#define DEG_TO_RAD              (3.14159265358979f / 180.0f)
+
+#define MAHONY_KP_DEFAULT       1.0f
+#define MADGWICK_BETA_DEFAULT   0.1f
+#define EKF_ACCEL_R             0.01f       /*!< Accelerometer measurement noise for the EKF update */
+/*==================[internal data declaration]==============================*/
+static attitude_config_t cfg;
+static bool initialized = false;
+static float accel_scale;                   /*!< raw -> m/s^2 */
+static float gyro_scale;                    /*!< raw -> rad/s */
+static float dt;
+static float gain;
+static float q[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+static float integral_fb[3];                /*!< Mahony integral feedback */
+static float last_accel[3];
+static float last_gyro[3];
+static ekf_imu13states *ekf13 = NULL;
+static dspm::Mat *ekf_H = NULL;             /*!< Accelerometer measurement Jacobian, allocated once */
+/*==================[internal functions declaration]=========================*/
+static void MahonyUpdate(const float g[3], const float a[3]);
+static void MadgwickUpdate(const float g[3], const float a[3]);
+static void EkfUpdate(const float g[3], const float a[3]);
+static void QuaternionNormalize(float *quat);
+static void EkfAccelModel(const float *quat, float expected[3]);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void QuaternionNormalize(float *quat){
+    float norm = sqrtf(quat[0] * quat[0] + quat[1] * quat[1] + quat[2] * quat[2] + quat[3] * quat[3]);
+    if (norm > 0.0f){
+        float inv = 1.0f / norm;
+        for (int i = 0; i < 4; i++){
+            quat[i] *= inv;
+        }
+    }
+}
+
+static void MahonyUpdate(const float g[3], const float a[3]){
+    float gx = g[0], gy = g[1], gz = g[2];
+    float norm = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    if (norm > 0.0f){
+        float ax = a[0] / norm, ay = a[1] / norm, az = a[2] / norm;
+        // Estimated direction of gravity in sensor frame
+        float vx = q[1] * q[3] - q[0] * q[2];
+        float vy = q[0] * q[1] + q[2] * q[3];
+        float vz = q[0] * q[0] - 0.5f + q[3] * q[3];
+        // Error is cross product between measured and estimated gravity
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+        if (cfg.ki > 0.0f){
+            integral_fb[0] += 2.0f * cfg.ki * ex * dt;
+            integral_fb[1] += 2.0f * cfg.ki * ey * dt;
+            integral_fb[2] += 2.0f * cfg.ki * ez * dt;
+        }
+        gx += 2.0f * gain * ex + integral_fb[0];
+        gy += 2.0f * gain * ey + integral_fb[1];
+        gz += 2.0f * gain * ez + integral_fb[2];
+    }
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    float qa = q[0], qb = q[1], qc = q[2];
+    q[0] += (-qb * gx - qc * gy - q[3] * gz);
+    q[1] += (qa * gx + qc * gz - q[3] * gy);
+    q[2] += (qa * gy - qb * gz + q[3] * gx);
+    q[3] += (qa * gz + qb * gy - qc * gx);
+    QuaternionNormalize(q);
+}
+
+static void MadgwickUpdate(const float g[3], const float a[3]){
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    // Rate of change of quaternion from gyroscope
+    float qdot0 = 0.5f * (-q1 * g[0] - q2 * g[1] - q3 * g[2]);
+    float qdot1 = 0.5f * (q0 * g[0] + q2 * g[2] - q3 * g[1]);
+    float qdot2 = 0.5f * (q0 * g[1] - q1 * g[2] + q3 * g[0]);
+    float qdot3 = 0.5f * (q0 * g[2] + q1 * g[1] - q2 * g[0]);
+
+    float norm = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    if (norm > 0.0f){
+        float ax = a[0] / norm, ay = a[1] / norm, az = a[2] / norm;
+        float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+        float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+        float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+        float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+        // Gradient descent corrective step
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        float s_norm = sqrtf(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+        if (s_norm > 0.0f){
+            float inv = gain / s_norm;
+            qdot0 -= inv * s0;
+            qdot1 -= inv * s1;
+            qdot2 -= inv * s2;
+            qdot3 -= inv * s3;
+        }
+    }
+    q[0] = q0 + qdot0 * dt;
+    q[1] = q1 + qdot1 * dt;
+    q[2] = q2 + qdot2 * dt;
+    q[3] = q3 + qdot3 * dt;
+    QuaternionNormalize(q);
+}
+
+/**
+ * @brief Expected accelerometer reading (rotm(q)' * accel0) and its derivative with respect
+ * to the quaternion (ekf::dFdq_inv()), written in place in the preallocated H.
+ */
+static void EkfAccelModel(const float *quat, float expected[3]){
+    const float *v = ekf13->accel0.data;
+    float q0 = quat[0], q1 = quat[1], q2 = quat[2], q3 = quat[3];
+    dspm::Mat &H = *ekf_H;
+
+    expected[0] = (q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * v[0] + 2.0f * (q1 * q2 + q0 * q3) * v[1] + 2.0f * (q1 * q3 - q0 * q2) * v[2];
+    expected[1] = 2.0f * (q1 * q2 - q0 * q3) * v[0] + (q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3) * v[1] + 2.0f * (q2 * q3 + q0 * q1) * v[2];
+    expected[2] = 2.0f * (q1 * q3 + q0 * q2) * v[0] + 2.0f * (q2 * q3 - q0 * q1) * v[1] + (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) * v[2];
+
+    H(0, 0) = 2.0f * (q0 * v[0] + q3 * v[1] - q2 * v[2]);
+    H(0, 1) = 2.0f * (q1 * v[0] + q2 * v[1] + q3 * v[2]);
+    H(0, 2) = 2.0f * (-q2 * v[0] + q1 * v[1] - q0 * v[2]);
+    H(0, 3) = 2.0f * (-q3 * v[0] + q0 * v[1] + q1 * v[2]);
+    H(1, 0) = 2.0f * (-q3 * v[0] + q0 * v[1] + q1 * v[2]);
+    H(1, 1) = 2.0f * (q2 * v[0] - q1 * v[1] + q0 * v[2]);
+    H(1, 2) = 2.0f * (q1 * v[0] + q2 * v[1] + q3 * v[2]);
+    H(1, 3) = 2.0f * (-q0 * v[0] - q3 * v[1] + q2 * v[2]);
+    H(2, 0) = 2.0f * (q2 * v[0] - q1 * v[1] + q0 * v[2]);
+    H(2, 1) = 2.0f * (q3 * v[0] - q0 * v[1] - q1 * v[2]);
+    H(2, 2) = 2.0f * (q0 * v[0] + q3 * v[1] - q2 * v[2]);
+    H(2, 3) = 2.0f * (q1 * v[0] + q2 * v[1] + q3 * v[2]);
+}
+
+static void EkfUpdate(const float g[3], const float a[3]){
+    float u[3] = {g[0], g[1], g[2]};
+    ekf13->Process(u, dt);
+
+    float norm = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    if (norm > 0.0f){
+        // Accelerometer only reference update, the MPU6050 has no magnetometer
+        float expected[3];
+        EkfAccelModel(ekf13->X.data, expected);
+        float measured[3] = {a[0] / norm, a[1] / norm, a[2] / norm};
+        float R[3] = {EKF_ACCEL_R, EKF_ACCEL_R, EKF_ACCEL_R};
+        ekf13->UpdateSequential(ekf_H->data, ekf_H->stride, ekf_H->rows, measured, expected, R);
+    }
+    QuaternionNormalize(ekf13->X.data);
+    memcpy(q, ekf13->X.data, sizeof(q));
+}
+
+/*==================[external functions definition]==========================*/
+bool AttitudeInit(const attitude_config_t *config){
+    if ((config == NULL) || (config->sample_freq <= 0.0f) ||
+        (config->accel_range > MAX_RANGE) || (config->gyro_range > MAX_RANGE)){
+        ESP_LOGE(TAG, "Invalid configuration");
+        return false;
+    }
+    AttitudeDeinit();
+    cfg = *config;
+    accel_scale = ATTITUDE_GRAVITY / (ACCEL_LSB_FS_2 / (float)(1 << cfg.accel_range));
+    gyro_scale = DEG_TO_RAD / (GYRO_LSB_FS_250 / (float)(1 << cfg.gyro_range));
+    dt = 1.0f / cfg.sample_freq;
+    switch (cfg.mode){
+        case ATTITUDE_MAHONY:
+            gain = (cfg.gain > 0.0f) ? cfg.gain : MAHONY_KP_DEFAULT;
+        break;
+        case ATTITUDE_MADGWICK:
+            gain = (cfg.gain > 0.0f) ? cfg.gain : MADGWICK_BETA_DEFAULT;
+        break;
+        case ATTITUDE_EKF:
+            ekf13 = new (std::nothrow) ekf_imu13states();
+            if (ekf13 == NULL){
+                ESP_LOGE(TAG, "Not enough memory for EKF");
+                return false;
+            }
+            ekf13->Init();
+            // Only the quaternion columns of H change between samples
+            ekf_H = new (std::nothrow) dspm::Mat(3, ekf13->NUMX);
+            if ((ekf_H == NULL) || (ekf_H->data == NULL)){
+                ESP_LOGE(TAG, "Not enough memory for EKF");
+                AttitudeDeinit();
+                return false;
+            }
+            *ekf_H *= 0;
+        break;
+        default:
+            ESP_LOGE(TAG, "Unknown mode");
+            return false;
+    }
+    initialized = true;
+    AttitudeReset();
+    return true;
+}
+
+void AttitudeDeinit(void){
+    if (ekf_H != NULL){
+        delete ekf_H;
+        ekf_H = NULL;
+    }
+    if (ekf13 != NULL){
+        delete ekf13;
+        ekf13 = NULL;
+    }
+    initialized = false;
+}
+
+void AttitudeReset(void){
+    q[0] = 1.0f;
+    q[1] = q[2] = q[3] = 0.0f;
+    memset(integral_fb, 0, sizeof(integral_fb));
+    memset(last_accel, 0, sizeof(last_accel));
+    memset(last_gyro, 0, sizeof(last_gyro));
+    if (ekf13 != NULL){
+        ekf13->X *= 0;
+        ekf13->P *= 0;
+        ekf13->Init();
+    }
+}
+
+bool AttitudeUpdate(void){
+    if (!initialized || (cfg.read_motion6 == NULL)){
+        return false;
+    }
+    int16_t accel[3], gyro[3];
+    cfg.read_motion6(&accel[0], &accel[1], &accel[2], &gyro[0], &gyro[1], &gyro[2]);
+    AttitudeProcessRaw(accel, gyro);
+    return true;
+}
+
+void AttitudeConvertRaw(const int16_t accel[3], const int16_t gyro[3], float accel_si[3], float gyro_si[3]){
+    for (int i = 0; i < 3; i++){
+        accel_si[i] = accel[i] * accel_scale;
+        gyro_si[i] = gyro[i] * gyro_scale;
+    }
+}
+
+void AttitudeProcessRaw(const int16_t accel[3], const int16_t gyro[3]){
+    if (!initialized){
+        return;
+    }
+    AttitudeConvertRaw(accel, gyro, last_accel, last_gyro);
+    switch (cfg.mode){
+        case ATTITUDE_MAHONY:
+            MahonyUpdate(last_gyro, last_accel);
+        break;
+        case ATTITUDE_MADGWICK:
+            MadgwickUpdate(last_gyro, last_accel);
+        break;
+        case ATTITUDE_EKF:
+            EkfUpdate(last_gyro, last_accel);
+        break;
+    }
+}
+
+void AttitudeGet(attitude_t *attitude){
+    float w = q[0], x = q[1], y = q[2], z = q[3];
+    memcpy(attitude->q, q, sizeof(q));
+    memcpy(attitude->accel, last_accel, sizeof(last_accel));
+    memcpy(attitude->gyro, last_gyro, sizeof(last_gyro));
+    float sinp = 2.0f * (w * y - z * x);
+    if (sinp > 1.0f){
+        sinp = 1.0f;
+    } else if (sinp < -1.0f){
+        sinp = -1.0f;
+    }
+    attitude->roll = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y));
+    attitude->pitch = asinf(sinp);
+    attitude->yaw = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+}
+
+/*==================[end of file]============================================*/
@@ -11,6 +11,7 @@
 
 /*==================[inclusions]=============================================*/
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 #include "fft.h"
 #include "esp_dsp.h"
@@ -20,17 +21,88 @@
 /*==================[internal data declaration]==============================*/
 static float fft_complex[2 * MAX_SIGNAL_LENGHT];
 static float wind[MAX_SIGNAL_LENGHT];
+static fftmr_fc32_t plans[FFT_PLAN_CACHE_SIZE];     /*!< Plans for non power of two lengths */
+static uint32_t plans_last_use[FFT_PLAN_CACHE_SIZE];
+static uint32_t plans_use_count = 0;
+static uint16_t wind_lenght = 0;                    /*!< Length of the window in wind array */
+static float * batch_buff = NULL;                   /*!< Data and working buffer of FFTMagnitudeBatch */
+static uint32_t batch_buff_size = 0;
 /*==================[internal functions declaration]=========================*/
+static fftmr_fc32_t * FFTGetPlan(uint16_t signal_lenght);
+static void FFTWindow(uint16_t signal_lenght);
+static bool FFTMagnitudeStep(const float * signal, uint16_t step, float * fft, uint16_t signal_lenght);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static fftmr_fc32_t * FFTGetPlan(uint16_t signal_lenght){
+    uint8_t lru = 0;
+    plans_use_count++;
+    for(uint8_t i=0; i<FFT_PLAN_CACHE_SIZE; i++){
+        if(plans[i].N == signal_lenght){
+            plans_last_use[i] = plans_use_count;
+            return &plans[i];
+        }
+        if(plans_last_use[i] < plans_last_use[lru]){
+            lru = i;
+        }
+    }
+    // Replace least recently used plan
+    if(plans[lru].N != 0){
+        dsps_fftmr_deinit_fc32(&plans[lru]);
+    }
+    if(dsps_fftmr_init_fc32(&plans[lru], signal_lenght) != ESP_OK){
+        ESP_LOGE(TAG, "Not enough memory for %d points FFT plan", signal_lenght);
+        plans_last_use[lru] = 0;
+        return NULL;
+    }
+    plans_last_use[lru] = plans_use_count;
+    return &plans[lru];
+}
+
+static void FFTWindow(uint16_t signal_lenght){
+    // Hann window is generated only when the signal length changes
+    if(wind_lenght != signal_lenght){
+        dsps_wind_hann_f32(wind, signal_lenght);
+        wind_lenght = signal_lenght;
+    }
+}
+
+static bool FFTMagnitudeStep(const float * signal, uint16_t step, float * fft, uint16_t signal_lenght){
+    FFTWindow(signal_lenght);
+    // Clear fft array
+    memset(fft_complex, 0, 2 * signal_lenght * sizeof(float));
+    // Multiply input array with window and store as real part
+    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, step, 1, 2);
+    // Calculate FFT (output already in natural order)
+    esp_err_t ret = ESP_FAIL;
+    if(dsp_is_power_of_two(signal_lenght)){
+        ret = dsps_fft4s_fc32(fft_complex, signal_lenght);
+    } else {
+        fftmr_fc32_t * plan = FFTGetPlan(signal_lenght);
+        if(plan != NULL){
+            ret = dsps_fftmr_fc32(plan, fft_complex);
+        }
+    }
+    if(ret != ESP_OK){
+        ESP_LOGE(TAG, "FFT failed, error code = %x", ret);
+        memset(fft, 0, (signal_lenght / 2) * sizeof(float));
+        return false;
+    }
+    // Calculate FFT magnitude (in place) and scale it (single sided spectrum, DC bin not doubled)
+    dsps_mag_fc32(fft_complex, fft_complex, signal_lenght / 2);
+    dsps_mulc_f32(fft_complex, fft_complex, signal_lenght / 2, 8.0f / signal_lenght, 1, 1);
+    fft_complex[0] = fft_complex[0] / 4;
+    // Copy result in fft array
+    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+    return true;
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
-    esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    esp_err_t ret = dsps_fft4s_init_fc32(NULL, MAX_SIGNAL_LENGHT);
     if (ret != ESP_OK){
         return false;
     }
@@ -38,25 +110,80 @@ bool FFTInit(void){
 }
 
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
+    FFTMagnitudeStep(signal, 1, fft, signal_lenght);
+}
+
+bool FFTMagnitudeBatch(const float * signals, float * fft[], uint16_t signal_lenght, uint8_t channels, fft_layout_t layout){
+    uint16_t in_step = (layout == FFT_INTERLEAVED) ? channels : 1;
+    uint16_t ch_step = (layout == FFT_INTERLEAVED) ? 1 : signal_lenght;
+    if(!dsp_is_power_of_two(signal_lenght)){
+        // Mixed radix plans have no batch mode, channels are processed one by one
+        for(uint8_t c=0; c<channels; c++){
+            if(!FFTMagnitudeStep(&signals[c * ch_step], in_step, fft[c], signal_lenght)){
+                return false;
+            }
+        }
+        return true;
+    }
+    uint32_t total = (uint32_t)signal_lenght * channels;
+    // Complex data and FFT working buffer
+    if(4 * total > batch_buff_size){
+        free(batch_buff);
+        batch_buff = (float *)malloc(4 * total * sizeof(float));
+        if(batch_buff == NULL){
+            ESP_LOGE(TAG, "Not enough memory for %d channels FFT", channels);
+            batch_buff_size = 0;
+            return false;
+        }
+        batch_buff_size = 4 * total;
+    }
+    float * data = batch_buff;
+    float * work = &batch_buff[2 * total];
+    FFTWindow(signal_lenght);
+    memset(data, 0, 2 * total * sizeof(float));
+    // Window every channel into the real parts, keeping the input layout
+    for(uint8_t c=0; c<channels; c++){
+        dsps_mul_f32(&signals[c * ch_step], wind, &data[2 * c * ch_step], signal_lenght, in_step, 1, 2 * in_step);
+    }
+    esp_err_t ret = dsps_fft4s_batch_fc32(data, signal_lenght, channels,
+                                          (layout == FFT_INTERLEAVED) ? DSPS_FFT_INTERLEAVED : DSPS_FFT_CHANNEL_MAJOR, work);
+    if(ret != ESP_OK){
+        ESP_LOGE(TAG, "Batch FFT failed, error code = %x", ret);
+        return false;
+    }
+    // Magnitudes to one array per channel, same scale as FFTMagnitude()
+    float scale = 8.0f / signal_lenght;
+    for(uint8_t c=0; c<channels; c++){
+        if(layout == FFT_INTERLEAVED){
+            for(uint16_t k=0; k<(signal_lenght / 2); k++){
+                float re = data[2 * (k * channels + c)];
+                float im = data[2 * (k * channels + c) + 1];
+                fft[c][k] = sqrtf(re * re + im * im) * scale;
+            }
+        } else {
+            dsps_mag_fc32(&data[2 * c * signal_lenght], fft[c], signal_lenght / 2);
+            dsps_mulc_f32(fft[c], fft[c], signal_lenght / 2, scale, 1, 1);
+        }
+        fft[c][0] = fft[c][0] / 4;
+    }
+    return true;
+}
+
+void FFTDeinit(void){
+    FFTFreePlans();
+    free(batch_buff);
+    batch_buff = NULL;
+    batch_buff_size = 0;
+    dsps_fft4s_deinit_fc32();
+}
+
+void FFTFreePlans(void){
+    for(uint8_t i=0; i<FFT_PLAN_CACHE_SIZE; i++){
+        if(plans[i].N != 0){
+            dsps_fftmr_deinit_fc32(&plans[i]);
+        }
+        plans_last_use[i] = 0;
     }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
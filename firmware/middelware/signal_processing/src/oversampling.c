@@ -0,0 +1,203 @@
+/**
+ * @file oversampling.c
+ * @brief ADC oversampling with a CIC + FIR decimation chain
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "oversampling.h"
+#include "esp_dsp.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Oversampling Module"
+
+#define ADC_MIDSCALE            2048        /*!< 12 bit raw midscale, the chain works on signed samples */
+#define ADC_MIDSCALE_BITS       11
+#define CIC_OUT_BITS            14          /*!< CIC output scaled to +-2^14, 1 bit headroom for the FIR */
+#define MAX_CIC_DECIM           32
+#define MAX_CIC_ORDER           4           /*!< 12 + 4 * log2(32) = 32 bits of CIC register growth */
+#define MAX_FIR_DECIM           8
+#define FIR_TAPS_PER_DECIM      16
+#define MAX_FIR_TAPS            (FIR_TAPS_PER_DECIM * MAX_FIR_DECIM - 1)
+#define FIR_PASSBAND            0.4f        /*!< Passband edge (of the output Nyquist band) */
+#define FIR_DESIGN_STEPS        64
+#define CHUNK_LEN               64          /*!< CIC outputs filtered at once, multiple of every FIR decimation */
+#define PI                      3.14159265358979f
+/*==================[internal data declaration]==============================*/
+typedef struct {
+    uint32_t integrator[MAX_CIC_ORDER];     /*!< Modular arithmetic, wraps are cancelled by the combs */
+    uint32_t comb[MAX_CIC_ORDER];
+    uint8_t phase;
+    int16_t pending[CHUNK_LEN];             /*!< CIC outputs waiting for the FIR */
+    uint16_t pending_len;
+    int16_t delay[MAX_FIR_TAPS];
+    fir_s16_t fir;
+} oversampling_ch_t;
+
+static oversampling_config_t cfg;
+static bool initialized = false;
+static int8_t cic_shift;                    /*!< Right shift from CIC register to CIC_OUT_BITS */
+static int16_t fir_taps;
+static int16_t fir_coeffs[MAX_FIR_TAPS];    /*!< Q15, shared by all the channels */
+static oversampling_ch_t state[OVERSAMPLING_MAX_CH];
+/*==================[internal functions declaration]=========================*/
+static void FirDesign(void);
+static uint16_t FirFlush(oversampling_ch_t *ch, uint16_t *output);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Low pass FIR with the inverse CIC response in the passband, designed by
+ * integrating the desired response (frequency sampling) and Hamming windowed.
+ */
+static void FirDesign(void){
+    float h[MAX_FIR_TAPS];
+    float fc = FIR_PASSBAND / cfg.fir_decim;    // cycles per CIC output sample
+    float df = fc / FIR_DESIGN_STEPS;
+    float m = (fir_taps - 1) * 0.5f;
+    float sum = 0;
+    for (int n = 0; n < fir_taps; n++){
+        float acc = 0;
+        for (int k = 0; k < FIR_DESIGN_STEPS; k++){
+            float f = (k + 0.5f) * df;
+            // CIC droop at f: (sin(pi f) / (R sin(pi f / R)))^N
+            float droop = sinf(PI * f) / (cfg.cic_decim * sinf(PI * f / cfg.cic_decim));
+            acc += cosf(2 * PI * f * (n - m)) / powf(droop, cfg.cic_order);
+        }
+        float wind = 0.54f - 0.46f * cosf(2 * PI * n / (fir_taps - 1));
+        h[n] = 2 * acc * df * wind;
+        sum += h[n];
+    }
+    // Unity DC gain
+    for (int n = 0; n < fir_taps; n++){
+        fir_coeffs[n] = (int16_t)lrintf(h[n] / sum * 32767.0f);
+    }
+}
+
+/**
+ * @brief Run the FIR over the pending CIC outputs (whole decimation periods only).
+ */
+static uint16_t FirFlush(oversampling_ch_t *ch, uint16_t *output){
+    uint16_t n = ch->pending_len / cfg.fir_decim;
+    if (n == 0){
+        return 0;
+    }
+    // Filtered in place in the output array, converted to unsigned afterwards
+    int16_t *filtered = (int16_t *)output;
+    dsps_fird_s16(&ch->fir, ch->pending, filtered, n);
+    uint16_t used = n * cfg.fir_decim;
+    ch->pending_len -= used;
+    memmove(ch->pending, &ch->pending[used], ch->pending_len * sizeof(int16_t));
+    for (uint16_t i = 0; i < n; i++){
+        int32_t value = (int32_t)filtered[i] * (1 << (16 - CIC_OUT_BITS - 1)) + 32768;
+        if (value < 0){
+            value = 0;
+        } else if (value > UINT16_MAX){
+            value = UINT16_MAX;
+        }
+        output[i] = value;
+    }
+    return n;
+}
+
+/*==================[external functions definition]==========================*/
+bool OversamplingInit(const oversampling_config_t *config){
+    if ((config == NULL) || (config->channels == 0) || (config->channels > OVERSAMPLING_MAX_CH) ||
+        (config->cic_decim < 2) || (config->cic_decim > MAX_CIC_DECIM) || (config->cic_decim & (config->cic_decim - 1)) ||
+        (config->cic_order == 0) || (config->cic_order > MAX_CIC_ORDER) ||
+        (config->fir_decim == 0) || (config->fir_decim > MAX_FIR_DECIM) || (config->fir_decim & (config->fir_decim - 1))){
+        ESP_LOGE(TAG, "Invalid configuration");
+        return false;
+    }
+    OversamplingDeinit();
+    cfg = *config;
+    // CIC gain is R^N: +-2^11 * R^N must end up as +-2^CIC_OUT_BITS
+    int8_t log2_decim = 0;
+    while ((1 << log2_decim) < cfg.cic_decim){
+        log2_decim++;
+    }
+    cic_shift = cfg.cic_order * log2_decim + ADC_MIDSCALE_BITS - CIC_OUT_BITS;
+    fir_taps = FIR_TAPS_PER_DECIM * cfg.fir_decim - 1;
+    FirDesign();
+    for (uint8_t i = 0; i < cfg.channels; i++){
+        if (dsps_fird_init_s16(&state[i].fir, fir_coeffs, state[i].delay, fir_taps, cfg.fir_decim, 0, 0) != ESP_OK){
+            ESP_LOGE(TAG, "FIR initialization failed");
+            OversamplingDeinit();
+            return false;
+        }
+    }
+    initialized = true;
+    OversamplingReset();
+    return true;
+}
+
+void OversamplingDeinit(void){
+    if (initialized){
+        for (uint8_t i = 0; i < cfg.channels; i++){
+            dsps_fird_s16_aexx_free(&state[i].fir);
+        }
+    }
+    initialized = false;
+}
+
+void OversamplingReset(void){
+    if (!initialized){
+        return;
+    }
+    for (uint8_t i = 0; i < cfg.channels; i++){
+        oversampling_ch_t *ch = &state[i];
+        memset(ch->integrator, 0, sizeof(ch->integrator));
+        memset(ch->comb, 0, sizeof(ch->comb));
+        memset(ch->delay, 0, sizeof(ch->delay));
+        ch->phase = 0;
+        ch->pending_len = 0;
+        ch->fir.pos = 0;
+        ch->fir.d_pos = 0;
+    }
+}
+
+uint16_t OversamplingProcess(uint8_t channel, const uint16_t *input, uint16_t *output, uint16_t len){
+    if (!initialized || (channel >= cfg.channels)){
+        return 0;
+    }
+    oversampling_ch_t *ch = &state[channel];
+    uint16_t out_len = 0;
+    for (uint16_t i = 0; i < len; i++){
+        uint32_t acc = (uint32_t)((int32_t)input[i] - ADC_MIDSCALE);
+        for (uint8_t s = 0; s < cfg.cic_order; s++){
+            ch->integrator[s] += acc;
+            acc = ch->integrator[s];
+        }
+        if (++ch->phase < cfg.cic_decim){
+            continue;
+        }
+        ch->phase = 0;
+        for (uint8_t s = 0; s < cfg.cic_order; s++){
+            uint32_t prev = ch->comb[s];
+            ch->comb[s] = acc;
+            acc -= prev;
+        }
+        int32_t cic = (int32_t)acc;
+        if (cic_shift > 0){
+            cic = (cic + (1 << (cic_shift - 1))) >> cic_shift;
+        } else {
+            cic *= (1 << -cic_shift);   // left shift of a negative value is undefined
+        }
+        ch->pending[ch->pending_len++] = cic;
+        if (ch->pending_len == CHUNK_LEN){
+            out_len += FirFlush(ch, &output[out_len]);
+        }
+    }
+    out_len += FirFlush(ch, &output[out_len]);
+    return out_len;
+}
+
+/*==================[end of file]============================================*/
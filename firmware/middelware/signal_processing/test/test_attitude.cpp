@@ -0,0 +1,87 @@
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_log.h"
+
+#include "attitude.h"
+
+static const char *TAG = "attitude";
+
+#define TEST_FREQ       100.0f
+#define TEST_SAMPLES    2000
+#define RAW_1G          16384       // MPU6050_ACCEL_FS_2
+#define RAW_1DPS        131         // MPU6050_GYRO_FS_250
+
+// Synthetic trace: sensor at rest with 30 deg roll, then rotating 45 deg/s around Z
+static void make_trace_sample(int n, int16_t accel[3], int16_t gyro[3])
+{
+    float roll = 30.0f * (float)M_PI / 180.0f;
+    accel[0] = 0;
+    accel[1] = (int16_t)(RAW_1G * sinf(roll));
+    accel[2] = (int16_t)(RAW_1G * cosf(roll));
+    gyro[0] = 0;
+    gyro[1] = 0;
+    gyro[2] = 0;
+    if (n >= TEST_SAMPLES) {
+        // Rotation around gravity (world Z) expressed in sensor frame
+        gyro[1] = (int16_t)(45 * RAW_1DPS * sinf(roll));
+        gyro[2] = (int16_t)(45 * RAW_1DPS * cosf(roll));
+    }
+}
+
+static void test_mode(attitude_mode_t mode, float ki, float tolerance_deg)
+{
+    attitude_config_t config = {
+        .mode = mode,
+        .accel_range = 0,
+        .gyro_range = 0,
+        .sample_freq = TEST_FREQ,
+        .gain = 0,
+        .ki = ki,
+        .read_motion6 = NULL,
+    };
+    TEST_ASSERT_TRUE(AttitudeInit(&config));
+    int16_t accel[3], gyro[3];
+    for (int n = 0; n < TEST_SAMPLES; n++) {
+        make_trace_sample(n, accel, gyro);
+        AttitudeProcessRaw(accel, gyro);
+    }
+    attitude_t att;
+    AttitudeGet(&att);
+    ESP_LOGI(TAG, "mode %i: roll = %f, pitch = %f", mode,
+             att.roll * 180 / M_PI, att.pitch * 180 / M_PI);
+    TEST_ASSERT_FLOAT_WITHIN(tolerance_deg, 30.0f, att.roll * 180 / M_PI);
+    TEST_ASSERT_FLOAT_WITHIN(tolerance_deg, 0.0f, att.pitch * 180 / M_PI);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 9.80665f * 0.5f, att.accel[1]);
+
+    float yaw0 = att.yaw;
+    for (int n = TEST_SAMPLES; n < TEST_SAMPLES + (int)TEST_FREQ; n++) {
+        make_trace_sample(n, accel, gyro);
+        AttitudeProcessRaw(accel, gyro);
+    }
+    AttitudeGet(&att);
+    float dyaw = (att.yaw - yaw0) * 180 / M_PI;
+    ESP_LOGI(TAG, "mode %i: yaw change = %f", mode, dyaw);
+    TEST_ASSERT_FLOAT_WITHIN(tolerance_deg, 45.0f, dyaw);
+    AttitudeDeinit();
+}
+
+TEST_CASE("attitude Mahony functionality", "[attitude]")
+{
+    test_mode(ATTITUDE_MAHONY, 0.0f, 2.0f);
+}
+
+TEST_CASE("attitude Mahony with integral feedback", "[attitude]")
+{
+    test_mode(ATTITUDE_MAHONY, 0.1f, 2.0f);
+}
+
+TEST_CASE("attitude Madgwick functionality", "[attitude]")
+{
+    test_mode(ATTITUDE_MADGWICK, 0.0f, 2.0f);
+}
+
+TEST_CASE("attitude EKF functionality", "[attitude]")
+{
+    test_mode(ATTITUDE_EKF, 0.0f, 3.0f);
+}
@@ -0,0 +1,162 @@
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_log.h"
+
+#include "oversampling.h"
+
+static const char *TAG = "oversampling";
+
+#define TEST_BLOCKS     2000        // Decimated samples per configuration
+#define TEST_SETTLE     64          // Decimated samples skipped while the filters settle
+#define TEST_AMP        500.0f      // Sine amplitude (raw counts)
+#define TEST_NOISE      20.0f       // Noise RMS (raw counts), dithers the 12 bit quantization
+#define TEST_MAX_BLOCK  4096        // Raw samples per OversamplingProcess() call
+
+static const oversampling_config_t test_configs[] = {
+    {.channels = 1, .cic_decim = 8, .cic_order = 3, .fir_decim = 2},    // 16x
+    {.channels = 1, .cic_decim = 16, .cic_order = 4, .fir_decim = 4},   // 64x
+    {.channels = 1, .cic_decim = 32, .cic_order = 4, .fir_decim = 8},   // 256x
+    {.channels = 1, .cic_decim = 2, .cic_order = 1, .fir_decim = 1},    // CIC gain below 2^3, scaled up
+};
+
+// Approximately gaussian noise, RMS 1
+static float test_noise(void)
+{
+    float sum = 0;
+    for (int i = 0; i < 12; i++) {
+        sum += (float)rand() / RAND_MAX;
+    }
+    return sum - 6.0f;
+}
+
+// Amplitude of the sine at f (cycles per sample) and RMS of the rest, least squares fit
+static void test_sine_fit(const float *x, int len, float f, float *amp, float *noise_rms)
+{
+    // Mean removed first, it isn't orthogonal to the sine over a fractional number of periods
+    double mean = 0;
+    for (int n = 0; n < len; n++) {
+        mean += x[n];
+    }
+    mean /= len;
+    double sc = 0, ss = 0, cc = 0, xs = 0, xc = 0;
+    for (int n = 0; n < len; n++) {
+        double s = sin(2 * M_PI * f * n);
+        double c = cos(2 * M_PI * f * n);
+        sc += s * c;
+        ss += s * s;
+        cc += c * c;
+        xs += (x[n] - mean) * s;
+        xc += (x[n] - mean) * c;
+    }
+    double det = ss * cc - sc * sc;
+    double a = (xs * cc - xc * sc) / det;
+    double b = (xc * ss - xs * sc) / det;
+    double err = 0;
+    for (int n = 0; n < len; n++) {
+        double e = x[n] - mean - a * sin(2 * M_PI * f * n) - b * cos(2 * M_PI * f * n);
+        err += e * e;
+    }
+    *amp = sqrt(a * a + b * b);
+    *noise_rms = sqrt(err / len);
+}
+
+// Raw samples fed in blocks, the length argument is 16 bit
+static int test_process(const uint16_t *input, uint16_t *output, int len)
+{
+    int out_len = 0;
+    for (int pos = 0; pos < len; pos += TEST_MAX_BLOCK) {
+        int n = (len - pos < TEST_MAX_BLOCK) ? (len - pos) : TEST_MAX_BLOCK;
+        out_len += OversamplingProcess(0, &input[pos], &output[out_len], n);
+    }
+    return out_len;
+}
+
+TEST_CASE("oversampling output length and DC gain", "[oversampling]")
+{
+    for (int t = 0; t < sizeof(test_configs) / sizeof(test_configs[0]); t++) {
+        const oversampling_config_t *config = &test_configs[t];
+        int decim = config->cic_decim * config->fir_decim;
+        int len = decim * TEST_BLOCKS;
+        uint16_t *input = (uint16_t *)malloc(len * sizeof(uint16_t));
+        uint16_t *output = (uint16_t *)malloc((TEST_BLOCKS + 1) * sizeof(uint16_t));
+        TEST_ASSERT_NOT_NULL(input);
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_TRUE(OversamplingInit(config));
+        for (int i = 0; i < len; i++) {
+            input[i] = 1000;
+        }
+        // Blocks of any length, the filters state is kept between calls
+        int out_len = 0;
+        int pos = 0;
+        int block = 1;
+        while (pos < len) {
+            int n = (len - pos < block) ? (len - pos) : block;
+            out_len += OversamplingProcess(0, &input[pos], &output[out_len], n);
+            pos += n;
+            block = (block * 3) % TEST_MAX_BLOCK + 1;
+        }
+        TEST_ASSERT_EQUAL(TEST_BLOCKS, out_len);
+        for (int i = TEST_SETTLE; i < out_len; i++) {
+            TEST_ASSERT_INT_WITHIN(16, 1000 * 16, output[i]);
+        }
+        ESP_LOGI(TAG, "%3ix: output / 16 = %f", decim, output[out_len - 1] / 16.0f);
+        // In place
+        int in_len = (len < TEST_MAX_BLOCK) ? len : TEST_MAX_BLOCK;
+        TEST_ASSERT_EQUAL(in_len / decim, OversamplingProcess(0, input, input, in_len));
+        TEST_ASSERT_INT_WITHIN(16, 1000 * 16, input[in_len / decim - 1]);
+        OversamplingDeinit();
+        free(input);
+        free(output);
+    }
+    oversampling_config_t invalid = test_configs[0];
+    invalid.cic_decim = 12;
+    TEST_ASSERT_FALSE(OversamplingInit(&invalid));
+    TEST_ASSERT_EQUAL(0, OversamplingProcess(0, NULL, NULL, 16));
+}
+
+TEST_CASE("oversampling SNR gain", "[oversampling]")
+{
+    srand(1);
+    // The first three configurations: 16x, 64x and 256x
+    for (int t = 0; t < 3; t++) {
+        const oversampling_config_t *config = &test_configs[t];
+        int decim = config->cic_decim * config->fir_decim;
+        int len = decim * TEST_BLOCKS;
+        // Sine at 1/10 of the output rate, inside the FIR passband
+        float f_out = 0.1f;
+        float f_in = f_out / decim;
+        uint16_t *input = (uint16_t *)malloc(len * sizeof(uint16_t));
+        uint16_t *output = (uint16_t *)malloc((TEST_BLOCKS + 1) * sizeof(uint16_t));
+        float *x = (float *)malloc(len * sizeof(float));
+        TEST_ASSERT_NOT_NULL(input);
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_NOT_NULL(x);
+        for (int i = 0; i < len; i++) {
+            input[i] = (uint16_t)lrintf(2048 + TEST_AMP * sinf(2 * M_PI * f_in * i) + TEST_NOISE * test_noise());
+            x[i] = input[i];
+        }
+        float amp_in, noise_in;
+        test_sine_fit(x, len, f_in, &amp_in, &noise_in);
+        TEST_ASSERT_TRUE(OversamplingInit(config));
+        int out_len = test_process(input, output, len);
+        TEST_ASSERT_EQUAL(TEST_BLOCKS, out_len);
+        for (int i = 0; i < out_len - TEST_SETTLE; i++) {
+            x[i] = output[i + TEST_SETTLE] / 16.0f;
+        }
+        float amp_out, noise_out;
+        test_sine_fit(x, out_len - TEST_SETTLE, f_out, &amp_out, &noise_out);
+        float gain_db = 20 * log10f((amp_out / noise_out) / (amp_in / noise_in));
+        float ideal_db = 10 * log10f(decim);
+        ESP_LOGI(TAG, "%3ix: amplitude %f -> %f, SNR gain %2.1f dB (ideal %2.1f dB)",
+                 decim, amp_in, amp_out, gain_db, ideal_db);
+        // Passband droop compensated by the FIR
+        TEST_ASSERT_FLOAT_WITHIN(0.02f * amp_in, amp_in, amp_out);
+        TEST_ASSERT_FLOAT_WITHIN(2.0f, ideal_db, gain_db);
+        OversamplingDeinit();
+        free(input);
+        free(output);
+        free(x);
+    }
+}